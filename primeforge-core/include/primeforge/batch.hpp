@@ -0,0 +1,70 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include "primeforge/device.hpp"
+#include "primeforge/types.hpp"
+
+namespace primeforge {
+
+// Sharded, resumable batch execution (primeforge-batch library; the core stays I/O free).
+//
+// Layout under a batch directory:
+//   manifest.tsv           shard order, content keys and spec ranges
+//   inputs/<key>.pfi       config + specs for one shard
+//   results/<key>.pfr      that shard's candidates, written atomically (tmp + rename)
+// Keys hash kDesignVersion and the shard's config and specs, so re-planning unchanged input
+// reuses results. Result files also record kDesignVersion; a result from another version
+// counts as incomplete and merge_batch refuses it.
+
+struct ShardInfo {
+  size_t index{0};
+  std::string key;   // 16 hex digits
+  size_t begin{0};   // first spec index in the original input
+  size_t end{0};     // exclusive
+};
+
+struct BatchPlan {
+  std::string dir;
+  size_t spec_count{0};
+  std::vector<ShardInfo> shards;
+};
+
+struct BatchRunStats {
+  size_t shards_total{0};
+  size_t shards_skipped{0};  // already complete on entry
+  size_t shards_run{0};
+};
+
+// Split edits into shards of at most shard_size specs and write inputs + manifest.
+BatchPlan plan_batch(const std::vector<PrimeEditSpec> &edits, const DesignConfig &cfg,
+                     const std::string &dir, size_t shard_size = 1024);
+
+// Re-read a plan written by plan_batch (e.g. from another process or machine).
+BatchPlan load_batch_plan(const std::string &dir);
+
+// True if the shard's result file exists, matches kDesignVersion and passes its checksum.
+bool is_shard_complete(const BatchPlan &plan, size_t shard_index);
+
+// Design one shard and atomically write its results. Safe to run from any process.
+void run_shard(const BatchPlan &plan, size_t shard_index, const Device &device = Device::cpu());
+
+// Reference runner: fork `workers` processes (POSIX) that split the incomplete shards
+// round-robin. workers <= 1 runs in-process. Throws if any shard fails.
+// Forking is only safe from a single-threaded caller: children run design code and
+// _exit(), but inherit any lock another thread held. workers > 1 with a CUDA device
+// throws std::invalid_argument (CUDA contexts do not survive fork).
+BatchRunStats run_batch_local(const BatchPlan &plan, int workers = 1,
+                              const Device &device = Device::cpu());
+
+// Concatenate all shard results in plan order into out_path. The bytes equal
+// write_batch_results(design_prime_edits(edits, cfg), out_path). Throws if a shard is
+// missing or corrupt.
+void merge_batch(const BatchPlan &plan, const std::string &out_path);
+
+void write_batch_results(const BatchCandidateList &batch, const std::string &path);
+BatchCandidateList read_batch_results(const std::string &path);
+
+}  // namespace primeforge
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "primeforge/device.hpp"
+#include "primeforge/types.hpp"
+
+namespace primeforge {
+
+// Read-only, mmap-backed view of a compact candidate file (primeforge-batch library).
+//
+// File layout (little-endian, blocks 8-byte aligned):
+//   "PFC1" u32 version
+//   per spec: u32 n, u32 seq_bytes, u32 spacer_count, u32 spacer_bytes, then columns of
+//             n entries: f64 pbs_gc, f64 rtt_gc, u32 spacer_id, i32 cut_index,
+//             u32 ngrna_spacer_id, i32 ngrna_cut_index, i32 edit_distance, u32 seq_offset,
+//             u16 pbs_len, u16 rtt_len, u8 flags; then PBS+RTT bases (2-bit packed unless
+//             flagged raw); then the spec's spacer dictionary: u32 offsets[spacer_count + 1],
+//             spacer bytes (ids index this block's dictionary only)
+//   spec index: u64 block_offset[spec_count]
+//   trailer: u64 spec_count, u64 index_offset, u32 version, "PFC1"
+class CandidateStore {
+ public:
+  // Map an existing candidate file; throws std::runtime_error if it is malformed.
+  static CandidateStore open(const std::string &path);
+
+  CandidateStore(CandidateStore &&other) noexcept;
+  CandidateStore &operator=(CandidateStore &&other) noexcept;
+  CandidateStore(const CandidateStore &) = delete;
+  CandidateStore &operator=(const CandidateStore &) = delete;
+  ~CandidateStore();
+
+  const std::string &path() const { return path_; }
+  size_t spec_count() const { return spec_count_; }
+  size_t candidate_count(size_t spec) const;
+  size_t spacer_count(size_t spec) const;  // distinct spacers in that spec's dictionary
+
+  // Decode one candidate or all candidates of one spec; only that spec's pages are touched.
+  // Throws std::runtime_error if an offset or length in the file points outside its section.
+  PrimeCandidate candidate(size_t spec, size_t index) const;
+  CandidateList candidates(size_t spec) const;
+
+ private:
+  CandidateStore() = default;
+  const uint8_t *block(size_t spec) const;  // bounds-checked start of a spec's block
+  std::string spacer(const uint8_t *block, uint32_t id) const;
+  void release();
+
+  std::string path_;
+  const uint8_t *data_{nullptr};
+  size_t size_{0};
+  size_t spec_count_{0};
+  const uint8_t *blocks_end_{nullptr};
+  const uint8_t *index_{nullptr};
+};
+
+struct SpillOptions {
+  // Encoded candidates buffered in memory before they are appended to the file. Besides
+  // the buffer, a run keeps only 8 bytes per spec (the block index) and the current spec.
+  size_t memory_budget_bytes{size_t{256} << 20};
+};
+
+// Design every spec, spilling finished results to `path` whenever the buffered encoding
+// exceeds the budget, then map the finished file. Peak memory is roughly the budget plus
+// one spec's CandidateList plus 8 bytes per spec.
+CandidateStore design_prime_edits_spilled(const std::vector<PrimeEditSpec> &edits,
+                                          const DesignConfig &cfg, const std::string &path,
+                                          const SpillOptions &opts = SpillOptions{},
+                                          const Device &device = Device::cpu());
+
+}  // namespace primeforge
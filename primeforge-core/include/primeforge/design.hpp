@@ -1,10 +1,16 @@
 #pragma once
 
+#include <cstdint>
+
 #include "primeforge/types.hpp"
 #include "primeforge/device.hpp"
 
 namespace primeforge {
 
+// Bumped whenever design_prime_edit output can change for the same input, so persisted
+// results (primeforge-batch) from another version are recognized as stale.
+inline constexpr uint32_t kDesignVersion = 2;
+
 CandidateList design_prime_edit(const PrimeEditSpec &edit, const DesignConfig &cfg,
                                 const Device &device = Device::cpu());
 
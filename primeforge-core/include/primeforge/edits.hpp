@@ -0,0 +1,71 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "primeforge/types.hpp"
+
+namespace primeforge {
+
+// An edit normalized to "replace ref[ref_start, ref_end) with alt".
+// Substitutions are 1bp replacements, insertions are empty ranges, deletions have empty alt.
+struct NormalizedEdit {
+  int ref_start{};
+  int ref_end{};  // exclusive
+  std::string alt;
+};
+
+// One replaced interval in both coordinate systems (half-open on each side).
+struct LiftBlock {
+  int ref_start{};
+  int ref_end{};
+  int edited_start{};
+  int edited_end{};
+};
+
+// Position lift-over between a reference window and its edited sequence.
+// Strand::Minus maps between the reverse-complement views of both sequences.
+// Positions inside a replaced interval map to the first base of the replacement in
+// the requested orientation; length sentinels (pos == size) map to each other.
+class LiftOver {
+ public:
+  LiftOver() = default;
+  LiftOver(int ref_length, int edited_length, std::vector<LiftBlock> blocks);
+
+  int ref_length() const { return ref_length_; }
+  int edited_length() const { return edited_length_; }
+
+  // Replaced intervals in ascending order for the given orientation.
+  const std::vector<LiftBlock> &blocks(Strand strand = Strand::Plus) const {
+    return strand == Strand::Minus ? minus_blocks_ : plus_blocks_;
+  }
+
+  int to_edited(int ref_pos, Strand strand = Strand::Plus) const;
+  // Like to_edited, but ref_pos names the boundary before that base (e.g. a nick): an
+  // insertion anchored there maps to its first inserted base instead of past it.
+  int to_edited_left(int ref_pos, Strand strand = Strand::Plus) const;
+  int to_reference(int edited_pos, Strand strand = Strand::Plus) const;
+
+ private:
+  int ref_length_{0};
+  int edited_length_{0};
+  std::vector<LiftBlock> plus_blocks_;
+  std::vector<LiftBlock> minus_blocks_;
+};
+
+struct EditedWindow {
+  std::string sequence;  // plus-strand edited sequence
+  LiftOver lift;
+};
+
+// Validate spec.edits against spec.ref_sequence and return them sorted by position.
+// Insertions at the same index are concatenated in input order. Throws
+// std::invalid_argument on out-of-range, overlapping, or ref-mismatched edits.
+std::vector<NormalizedEdit> normalize_edits(const PrimeEditSpec &spec);
+
+// Build the edited sequence in a single pass over the window plus its lift-over map.
+EditedWindow apply_edits(const PrimeEditSpec &spec);
+EditedWindow apply_edits(const std::string &ref_sequence,
+                         const std::vector<NormalizedEdit> &edits);
+
+}  // namespace primeforge
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+#include "primeforge/device.hpp"
+#include "primeforge/types.hpp"
+
+namespace primeforge {
+
+struct SpecState;
+
+// Work counters; compare before/after a design() call to see what a config change cost.
+struct DesignSessionStats {
+  size_t pam_scans{0};   // motif scans (both strands) of one spec
+  size_t pbs_built{0};   // PBS sequences reverse-complemented and GC-scored
+  size_t rtt_built{0};   // RTT sequences sliced and GC-scored
+};
+
+// Reusable design state for interactive parameter sweeps over one batch.
+//
+// Keeps, per spec, the validated edited view, PAM hits and nick sites per motif, and
+// every PBS/RTT already built. design() with a new DesignConfig scans only motifs not
+// seen before and builds only PBS/RTT lengths not built before; results are identical
+// to design_prime_edits(edits, cfg, device). Cached state grows with the union of all
+// configs used. Not thread-safe.
+class DesignSession {
+ public:
+  // Validates every spec up front (throws std::invalid_argument like design_prime_edit).
+  explicit DesignSession(std::vector<PrimeEditSpec> edits, const Device &device = Device::cpu());
+  DesignSession(DesignSession &&) noexcept;
+  DesignSession &operator=(DesignSession &&) noexcept;
+  ~DesignSession();
+
+  size_t spec_count() const { return edits_.size(); }
+  const std::vector<PrimeEditSpec> &edits() const { return edits_; }
+  const DesignSessionStats &stats() const { return stats_; }
+
+  BatchCandidateList design(const DesignConfig &cfg);
+  CandidateList design_one(size_t spec, const DesignConfig &cfg);
+
+ private:
+  std::vector<PrimeEditSpec> edits_;
+  Device device_;
+  std::vector<std::unique_ptr<SpecState>> states_;
+  DesignSessionStats stats_;
+};
+
+}  // namespace primeforge
@@ -0,0 +1,326 @@
+#include "primeforge/batch.hpp"
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <filesystem>
+#include <sstream>
+#include <stdexcept>
+
+#include "io.hpp"
+#include "primeforge/design.hpp"
+#include "serialize.hpp"
+
+namespace primeforge {
+namespace fs = std::filesystem;
+namespace {
+
+constexpr char kInputMagic[] = "PFI1";
+constexpr char kResultMagic[] = "PFR1";
+constexpr uint32_t kFormatVersion = 3;
+constexpr size_t kResultHeaderBytes = 20;  // magic, format, design version, spec count
+constexpr char kManifestHeader[] = "primeforge-batch";
+
+std::string hex64(uint64_t v) {
+  static const char digits[] = "0123456789abcdef";
+  std::string s(16, '0');
+  for (int i = 15; i >= 0; --i, v >>= 4) s[i] = digits[v & 0xF];
+  return s;
+}
+
+fs::path input_path(const BatchPlan &plan, const ShardInfo &shard) {
+  return fs::path(plan.dir) / "inputs" / (shard.key + ".pfi");
+}
+
+fs::path result_path(const BatchPlan &plan, const ShardInfo &shard) {
+  return fs::path(plan.dir) / "results" / (shard.key + ".pfr");
+}
+
+const ShardInfo &shard_at(const BatchPlan &plan, size_t shard_index) {
+  if (shard_index >= plan.shards.size()) throw std::out_of_range("shard index outside plan");
+  return plan.shards[shard_index];
+}
+
+void write_result_header(ByteWriter &w, uint64_t spec_count) {
+  w.raw(kResultMagic);
+  w.u32(kFormatVersion);
+  w.u32(kDesignVersion);
+  w.u64(spec_count);
+}
+
+// Validate a result file and return the view of its per-spec records. The trailing
+// checksum covers the header too, so a flipped version or count is caught.
+std::string_view result_records(std::string_view bytes, uint64_t *spec_count,
+                                const fs::path &path) {
+  if (bytes.size() < kResultHeaderBytes + 8) {
+    throw std::runtime_error("result file truncated: " + path.string());
+  }
+  const std::string_view body = bytes.substr(0, bytes.size() - 8);
+  ByteReader r(body);
+  if (r.raw(4) != kResultMagic || r.u32() != kFormatVersion) {
+    throw std::runtime_error("not a primeforge result file: " + path.string());
+  }
+  ByteReader tail(bytes.substr(body.size()));
+  if (tail.u64() != fnv1a64(body)) {
+    throw std::runtime_error("result file checksum mismatch: " + path.string());
+  }
+  const uint32_t design_version = r.u32();
+  if (design_version != kDesignVersion) {
+    throw std::runtime_error("result file from design version " + std::to_string(design_version) +
+                             " (expected " + std::to_string(kDesignVersion) +
+                             "): " + path.string());
+  }
+  *spec_count = r.u64();
+  std::string_view records = r.raw(r.remaining());
+  // Every spec record starts with a u32 candidate count; bounds allocations by callers.
+  if (*spec_count > records.size() / 4) {
+    throw std::runtime_error("result file spec count exceeds its records: " + path.string());
+  }
+  return records;
+}
+
+struct ShardInput {
+  DesignConfig cfg;
+  std::vector<PrimeEditSpec> specs;
+};
+
+ShardInput read_shard_input(const fs::path &path) {
+  const std::string bytes = read_file(path);
+  if (bytes.size() < 8) throw std::runtime_error("shard input truncated: " + path.string());
+  const std::string_view body(bytes.data(), bytes.size() - 8);
+  ByteReader tail(std::string_view(bytes).substr(body.size()));
+  if (tail.u64() != fnv1a64(body)) {
+    throw std::runtime_error("shard input checksum mismatch: " + path.string());
+  }
+  ByteReader r(body);
+  if (r.raw(4) != kInputMagic || r.u32() != kFormatVersion) {
+    throw std::runtime_error("not a primeforge shard input: " + path.string());
+  }
+  r.u32();  // design version at planning time; only feeds the key
+  ShardInput in;
+  in.cfg = decode_config(r);
+  in.specs.resize(r.u64());
+  for (auto &s : in.specs) s = decode_spec(r);
+  return in;
+}
+
+void write_manifest(const BatchPlan &plan) {
+  std::ostringstream out;
+  out << kManifestHeader << '\t' << kFormatVersion << '\n';
+  out << "specs\t" << plan.spec_count << '\n';
+  out << "shards\t" << plan.shards.size() << '\n';
+  for (const auto &s : plan.shards) {
+    out << s.index << '\t' << s.key << '\t' << s.begin << '\t' << s.end << '\n';
+  }
+  write_file_atomic(fs::path(plan.dir) / "manifest.tsv", out.str());
+}
+
+}  // namespace
+
+BatchPlan plan_batch(const std::vector<PrimeEditSpec> &edits, const DesignConfig &cfg,
+                     const std::string &dir, size_t shard_size) {
+  if (shard_size == 0) throw std::invalid_argument("shard_size must be positive");
+  fs::create_directories(fs::path(dir) / "inputs");
+  fs::create_directories(fs::path(dir) / "results");
+
+  ByteWriter cfg_bytes;
+  encode_config(cfg_bytes, cfg);
+
+  BatchPlan plan;
+  plan.dir = dir;
+  plan.spec_count = edits.size();
+  for (size_t begin = 0; begin < edits.size(); begin += shard_size) {
+    const size_t end = std::min(edits.size(), begin + shard_size);
+
+    ByteWriter w;
+    w.raw(kInputMagic);
+    w.u32(kFormatVersion);
+    w.u32(kDesignVersion);  // new design output gets new keys
+    w.raw(cfg_bytes.bytes());
+    w.u64(end - begin);
+    for (size_t i = begin; i < end; ++i) encode_spec(w, edits[i]);
+
+    ShardInfo shard{plan.shards.size(), hex64(fnv1a64(w.bytes())), begin, end};
+    w.u64(fnv1a64(w.bytes()));
+    const fs::path path = input_path(plan, shard);
+    if (!fs::exists(path)) write_file_atomic(path, w.bytes());
+    plan.shards.push_back(std::move(shard));
+  }
+  write_manifest(plan);
+  return plan;
+}
+
+BatchPlan load_batch_plan(const std::string &dir) {
+  const fs::path path = fs::path(dir) / "manifest.tsv";
+  std::istringstream in(read_file(path));
+  std::string header, key;
+  uint32_t version = 0;
+  size_t n_shards = 0;
+  BatchPlan plan;
+  plan.dir = dir;
+  if (!(in >> header >> version) || header != kManifestHeader || version != kFormatVersion) {
+    throw std::runtime_error("not a primeforge batch manifest: " + path.string());
+  }
+  if (!(in >> key >> plan.spec_count) || key != "specs" || !(in >> key >> n_shards) ||
+      key != "shards") {
+    throw std::runtime_error("malformed batch manifest: " + path.string());
+  }
+  // Shards are non-empty, so a count above spec_count is corrupt (and not allocated).
+  if (n_shards > plan.spec_count) {
+    throw std::runtime_error("malformed batch manifest: " + path.string());
+  }
+  plan.shards.resize(n_shards);
+  size_t next_begin = 0;
+  for (size_t i = 0; i < n_shards; ++i) {
+    auto &s = plan.shards[i];
+    // merge_batch trusts the plan: shards must be in order and tile [0, spec_count).
+    if (!(in >> s.index >> s.key >> s.begin >> s.end) || s.index != i || s.key.size() != 16 ||
+        s.begin != next_begin || s.end <= s.begin) {
+      throw std::runtime_error("malformed batch manifest: " + path.string());
+    }
+    next_begin = s.end;
+  }
+  if (next_begin != plan.spec_count) {
+    throw std::runtime_error("malformed batch manifest: " + path.string());
+  }
+  return plan;
+}
+
+bool is_shard_complete(const BatchPlan &plan, size_t shard_index) {
+  const ShardInfo &shard = shard_at(plan, shard_index);
+  const fs::path path = result_path(plan, shard);
+  if (!fs::exists(path)) return false;
+  try {
+    const std::string bytes = read_file(path);
+    uint64_t spec_count = 0;
+    result_records(bytes, &spec_count, path);
+    return spec_count == shard.end - shard.begin;
+  } catch (const std::runtime_error &) {
+    return false;  // torn, foreign or stale-version file; the shard is rerun and overwritten
+  }
+}
+
+void run_shard(const BatchPlan &plan, size_t shard_index, const Device &device) {
+  const ShardInfo &shard = shard_at(plan, shard_index);
+  const ShardInput in = read_shard_input(input_path(plan, shard));
+  if (in.specs.size() != shard.end - shard.begin) {
+    throw std::runtime_error("shard input does not match manifest: " + shard.key);
+  }
+
+  ByteWriter records;
+  for (const auto &spec : in.specs) {
+    encode_candidates(records, design_prime_edit(spec, in.cfg, device));
+  }
+  ByteWriter w;
+  write_result_header(w, in.specs.size());
+  w.raw(records.bytes());
+  w.u64(fnv1a64(w.bytes()));
+  write_file_atomic(result_path(plan, shard), w.bytes());
+}
+
+BatchRunStats run_batch_local(const BatchPlan &plan, int workers, const Device &device) {
+  // A CUDA context does not survive fork(); GPU runs use one process per device instead.
+  if (workers > 1 && device.type == DeviceType::CUDA) {
+    throw std::invalid_argument("run_batch_local: forked workers need a CPU device; run one "
+                                "run_shard process per GPU instead");
+  }
+  BatchRunStats stats;
+  stats.shards_total = plan.shards.size();
+  std::vector<size_t> pending;
+  for (size_t i = 0; i < plan.shards.size(); ++i) {
+    if (is_shard_complete(plan, i)) {
+      ++stats.shards_skipped;
+    } else {
+      pending.push_back(i);
+    }
+  }
+  stats.shards_run = pending.size();
+
+  workers = std::max(1, std::min(workers, static_cast<int>(pending.size())));
+  if (workers == 1) {
+    for (size_t idx : pending) run_shard(plan, idx, device);
+    return stats;
+  }
+
+  std::vector<pid_t> children;
+  for (int w = 0; w < workers; ++w) {
+    const pid_t pid = ::fork();
+    if (pid < 0) io_error("cannot fork worker for", plan.dir);
+    if (pid == 0) {
+      // Child: never return into the caller's stack or run its atexit handlers.
+      int code = 0;
+      try {
+        for (size_t j = static_cast<size_t>(w); j < pending.size(); j += workers) {
+          run_shard(plan, pending[j], device);
+        }
+      } catch (const std::exception &e) {
+        std::fprintf(stderr, "primeforge worker %d: %s\n", w, e.what());
+        code = 1;
+      }
+      ::_exit(code);
+    }
+    children.push_back(pid);
+  }
+
+  int failed = 0;
+  for (pid_t pid : children) {
+    int status = 0;
+    while (::waitpid(pid, &status, 0) < 0 && errno == EINTR) {
+    }
+    if (!WIFEXITED(status) || WEXITSTATUS(status) != 0) ++failed;
+  }
+  if (failed > 0) {
+    throw std::runtime_error(std::to_string(failed) + " batch worker(s) failed in " + plan.dir);
+  }
+  return stats;
+}
+
+void merge_batch(const BatchPlan &plan, const std::string &out_path) {
+  AtomicFile out(out_path);
+  ByteWriter header;
+  write_result_header(header, plan.spec_count);
+  out.write(header.bytes());
+
+  uint64_t checksum = fnv1a64(header.bytes());
+  for (const auto &shard : plan.shards) {
+    const fs::path path = result_path(plan, shard);
+    const std::string bytes = read_file(path);
+    uint64_t spec_count = 0;
+    const std::string_view records = result_records(bytes, &spec_count, path);
+    if (spec_count != shard.end - shard.begin) {
+      throw std::runtime_error("shard result does not match manifest: " + path.string());
+    }
+    checksum = fnv1a64(records, checksum);
+    out.write(records);
+  }
+
+  ByteWriter trailer;
+  trailer.u64(checksum);
+  out.write(trailer.bytes());
+  out.commit();
+}
+
+void write_batch_results(const BatchCandidateList &batch, const std::string &path) {
+  ByteWriter records;
+  for (const auto &cands : batch) encode_candidates(records, cands);
+  ByteWriter w;
+  write_result_header(w, batch.size());
+  w.raw(records.bytes());
+  w.u64(fnv1a64(w.bytes()));
+  write_file_atomic(path, w.bytes());
+}
+
+BatchCandidateList read_batch_results(const std::string &path) {
+  const std::string bytes = read_file(path);
+  uint64_t spec_count = 0;
+  ByteReader r(result_records(bytes, &spec_count, path));
+  BatchCandidateList batch(spec_count);
+  for (auto &cands : batch) cands = decode_candidates(r);
+  if (r.remaining() != 0) throw std::runtime_error("trailing bytes in result file: " + path);
+  return batch;
+}
+
+}  // namespace primeforge
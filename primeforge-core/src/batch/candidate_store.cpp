@@ -0,0 +1,354 @@
+#include "primeforge/candidate_store.hpp"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+
+#include "../cpu/seq_kernels.hpp"
+#include "io.hpp"
+#include "primeforge/design.hpp"
+#include "serialize.hpp"
+
+namespace primeforge {
+namespace {
+
+constexpr char kStoreMagic[] = "PFC1";
+constexpr uint32_t kStoreVersion = 2;
+constexpr size_t kHeaderBytes = 8;
+constexpr size_t kTrailerBytes = 24;
+constexpr size_t kBlockHeaderBytes = 16;
+constexpr uint32_t kNoSpacer = std::numeric_limits<uint32_t>::max();
+
+enum CandidateFlags : uint8_t {
+  kPbsGcExtreme = 1 << 0,
+  kEditFar = 1 << 1,
+  kHasNgrna = 1 << 2,
+  kNgrnaPe3b = 1 << 3,
+  kRawBases = 1 << 4,  // PBS/RTT stored verbatim (lowercase or non-ACGT present)
+};
+
+uint64_t load_le(const uint8_t *p, int width) {
+  uint64_t v = 0;
+  for (int i = 0; i < width; ++i) v |= static_cast<uint64_t>(p[i]) << (8 * i);
+  return v;
+}
+
+uint16_t load_u16(const uint8_t *p) { return static_cast<uint16_t>(load_le(p, 2)); }
+uint32_t load_u32(const uint8_t *p) { return static_cast<uint32_t>(load_le(p, 4)); }
+uint64_t load_u64(const uint8_t *p) { return load_le(p, 8); }
+int32_t load_i32(const uint8_t *p) { return static_cast<int32_t>(load_u32(p)); }
+double load_f64(const uint8_t *p) {
+  const uint64_t bits = load_u64(p);
+  double v = 0.0;
+  std::memcpy(&v, &bits, sizeof(v));
+  return v;
+}
+
+// Byte offsets of each section inside a block holding n candidates.
+struct BlockLayout {
+  BlockLayout(size_t n, size_t seq_bytes, size_t spacers)
+      : pbs_gc(kBlockHeaderBytes), rtt_gc(pbs_gc + 8 * n), spacer_id(rtt_gc + 8 * n),
+        cut_index(spacer_id + 4 * n), ngrna_spacer_id(cut_index + 4 * n),
+        ngrna_cut_index(ngrna_spacer_id + 4 * n), edit_distance(ngrna_cut_index + 4 * n),
+        seq_offset(edit_distance + 4 * n), pbs_len(seq_offset + 4 * n),
+        rtt_len(pbs_len + 2 * n), flags(rtt_len + 2 * n), seq(flags + n),
+        dict_offsets(seq + seq_bytes), dict_bytes(dict_offsets + 4 * (spacers + 1)) {}
+
+  // Reads the block header; sizes are u32, so offsets cannot overflow size_t.
+  explicit BlockLayout(const uint8_t *block)
+      : BlockLayout(load_u32(block), load_u32(block + 4), load_u32(block + 8)) {}
+
+  size_t pbs_gc, rtt_gc, spacer_id, cut_index, ngrna_spacer_id, ngrna_cut_index,
+      edit_distance, seq_offset, pbs_len, rtt_len, flags, seq, dict_offsets, dict_bytes;
+};
+
+bool packable(const std::string &s) {
+  for (char c : s) {
+    if (c != 'A' && c != 'C' && c != 'G' && c != 'T') return false;
+  }
+  return true;
+}
+
+void unpack_2bit(const uint8_t *packed, size_t n, std::string &out) {
+  static const char kBases[4] = {'A', 'C', 'G', 'T'};
+  out.resize(n);
+  for (size_t i = 0; i < n; ++i) out[i] = kBases[(packed[i / 4] >> (2 * (i % 4))) & 3];
+}
+
+void pad8(ByteWriter &w) {
+  while (w.bytes().size() % 8 != 0) w.u8(0);
+}
+
+// Distinct spacers of one block. Spacers rarely repeat across specs, so the dictionary
+// is per block: it dedups the pegRNA/ngRNA spacers shared by a spec's candidates and is
+// freed with the block, keeping memory independent of library size.
+class SpacerDictionary {
+ public:
+  uint32_t id(std::string_view spacer) {
+    auto [it, inserted] = ids_.try_emplace(spacer, static_cast<uint32_t>(order_.size()));
+    if (inserted) order_.push_back(spacer);
+    return it->second;
+  }
+
+  size_t size() const { return order_.size(); }
+
+  size_t byte_size() const {
+    size_t n = 0;
+    for (auto s : order_) n += s.size();
+    return n;
+  }
+
+  void encode(ByteWriter &w) const {
+    uint32_t offset = 0;
+    w.u32(offset);
+    for (auto s : order_) {
+      offset += static_cast<uint32_t>(s.size());
+      w.u32(offset);
+    }
+    for (auto s : order_) w.raw(s);
+  }
+
+ private:
+  std::unordered_map<std::string_view, uint32_t> ids_;  // views into the encoded candidates
+  std::vector<std::string_view> order_;
+};
+
+// Append one spec's block; the writer must be 8-byte aligned on entry and is on exit.
+void encode_block(ByteWriter &w, const CandidateList &cands) {
+  const size_t n = cands.size();
+  std::string seq;
+  std::vector<uint32_t> seq_offsets(n);
+  std::vector<uint8_t> flags(n);
+  std::vector<uint32_t> spacer_ids(n);
+  std::vector<uint32_t> ngrna_spacer_ids(n, kNoSpacer);
+  SpacerDictionary dict;
+  const SeqKernels &kernels = seq_kernels();
+  for (size_t i = 0; i < n; ++i) {
+    const auto &c = cands[i];
+    if (c.peg.pbs.size() > 0xFFFF || c.peg.rtt.size() > 0xFFFF) {
+      throw std::invalid_argument("PBS/RTT longer than 65535 bases cannot be stored");
+    }
+    spacer_ids[i] = dict.id(c.peg.spacer);
+    if (c.ngrna) ngrna_spacer_ids[i] = dict.id(c.ngrna->spacer);
+    seq_offsets[i] = static_cast<uint32_t>(seq.size());
+    uint8_t f = 0;
+    if (c.heuristics.flag_pbs_gc_extreme) f |= kPbsGcExtreme;
+    if (c.heuristics.flag_edit_far) f |= kEditFar;
+    if (c.ngrna) f |= kHasNgrna;
+    if (c.ngrna && c.ngrna->is_pe3b) f |= kNgrnaPe3b;
+    if (packable(c.peg.pbs) && packable(c.peg.rtt)) {
+      for (const std::string *part : {&c.peg.pbs, &c.peg.rtt}) {
+        const size_t at = seq.size();
+        seq.resize(at + (part->size() + 3) / 4);
+        kernels.pack_2bit(part->data(), part->size(), reinterpret_cast<uint8_t *>(seq.data() + at));
+      }
+    } else {
+      f |= kRawBases;
+      seq += c.peg.pbs;
+      seq += c.peg.rtt;
+    }
+    flags[i] = f;
+  }
+
+  w.u32(static_cast<uint32_t>(n));
+  w.u32(static_cast<uint32_t>(seq.size()));
+  w.u32(static_cast<uint32_t>(dict.size()));
+  w.u32(static_cast<uint32_t>(dict.byte_size()));
+  for (const auto &c : cands) w.f64(c.heuristics.pbs_gc);
+  for (const auto &c : cands) w.f64(c.heuristics.rtt_gc);
+  for (uint32_t id : spacer_ids) w.u32(id);
+  for (const auto &c : cands) w.i32(c.peg.cut_index);
+  for (uint32_t id : ngrna_spacer_ids) w.u32(id);
+  for (const auto &c : cands) w.i32(c.ngrna ? c.ngrna->cut_index : 0);
+  for (const auto &c : cands) w.i32(c.heuristics.edit_distance_from_nick);
+  for (uint32_t off : seq_offsets) w.u32(off);
+  for (const auto &c : cands) w.u16(static_cast<uint16_t>(c.peg.pbs.size()));
+  for (const auto &c : cands) w.u16(static_cast<uint16_t>(c.peg.rtt.size()));
+  for (uint8_t f : flags) w.u8(f);
+  w.raw(seq);
+  dict.encode(w);
+  pad8(w);
+}
+
+[[noreturn]] void malformed(const std::string &path) {
+  throw std::runtime_error("malformed candidate file: " + path);
+}
+
+}  // namespace
+
+CandidateStore CandidateStore::open(const std::string &path) {
+  const int fd = ::open(path.c_str(), O_RDONLY);
+  if (fd < 0) io_error("cannot open", path);
+  struct stat st {};
+  if (::fstat(fd, &st) != 0) {
+    ::close(fd);
+    io_error("cannot stat", path);
+  }
+  const size_t size = static_cast<size_t>(st.st_size);
+  if (size < kHeaderBytes + kTrailerBytes) {
+    ::close(fd);
+    malformed(path);
+  }
+  void *map = ::mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+  ::close(fd);
+  if (map == MAP_FAILED) io_error("cannot mmap", path);
+
+  CandidateStore store;
+  store.path_ = path;
+  store.data_ = static_cast<const uint8_t *>(map);
+  store.size_ = size;
+
+  const uint8_t *trailer = store.data_ + size - kTrailerBytes;
+  if (std::memcmp(store.data_, kStoreMagic, 4) != 0 || load_u32(store.data_ + 4) != kStoreVersion ||
+      std::memcmp(trailer + 20, kStoreMagic, 4) != 0 || load_u32(trailer + 16) != kStoreVersion) {
+    malformed(path);
+  }
+  store.spec_count_ = load_u64(trailer);
+  const uint64_t index_offset = load_u64(trailer + 8);
+  if (index_offset < kHeaderBytes || index_offset > size - kTrailerBytes ||
+      (size - kTrailerBytes - index_offset) % 8 != 0 ||
+      (size - kTrailerBytes - index_offset) / 8 != store.spec_count_) {
+    malformed(path);
+  }
+  store.blocks_end_ = store.data_ + index_offset;
+  store.index_ = store.data_ + index_offset;
+  return store;
+}
+
+CandidateStore::CandidateStore(CandidateStore &&other) noexcept { *this = std::move(other); }
+
+CandidateStore &CandidateStore::operator=(CandidateStore &&other) noexcept {
+  if (this != &other) {
+    release();
+    path_ = std::move(other.path_);
+    data_ = std::exchange(other.data_, nullptr);
+    size_ = std::exchange(other.size_, 0);
+    spec_count_ = std::exchange(other.spec_count_, 0);
+    blocks_end_ = std::exchange(other.blocks_end_, nullptr);
+    index_ = std::exchange(other.index_, nullptr);
+  }
+  return *this;
+}
+
+CandidateStore::~CandidateStore() { release(); }
+
+void CandidateStore::release() {
+  if (data_) ::munmap(const_cast<uint8_t *>(data_), size_);
+  data_ = nullptr;
+}
+
+const uint8_t *CandidateStore::block(size_t spec) const {
+  if (spec >= spec_count_) throw std::out_of_range("spec index outside candidate file");
+  const uint64_t offset = load_u64(index_ + 8 * spec);
+  const uint64_t limit = static_cast<uint64_t>(blocks_end_ - data_);
+  if (offset < kHeaderBytes || offset + kBlockHeaderBytes > limit) malformed(path_);
+  const uint8_t *b = data_ + offset;
+  const BlockLayout at(b);
+  if (at.dict_bytes > limit - offset || load_u32(b + 12) > limit - offset - at.dict_bytes) {
+    malformed(path_);
+  }
+  return b;
+}
+
+std::string CandidateStore::spacer(const uint8_t *block, uint32_t id) const {
+  const BlockLayout at(block);
+  if (id >= load_u32(block + 8)) malformed(path_);
+  const uint64_t begin = load_u32(block + at.dict_offsets + 4 * id);
+  const uint64_t end = load_u32(block + at.dict_offsets + 4 * (id + 1));
+  // Spacer bytes fit the block (checked by block()); offsets must stay inside them.
+  if (begin > end || end > load_u32(block + 12)) malformed(path_);
+  return std::string(reinterpret_cast<const char *>(block + at.dict_bytes + begin), end - begin);
+}
+
+size_t CandidateStore::candidate_count(size_t spec) const { return load_u32(block(spec)); }
+
+size_t CandidateStore::spacer_count(size_t spec) const { return load_u32(block(spec) + 8); }
+
+PrimeCandidate CandidateStore::candidate(size_t spec, size_t index) const {
+  const uint8_t *b = block(spec);
+  const size_t n = load_u32(b);
+  if (index >= n) throw std::out_of_range("candidate index outside spec");
+  const BlockLayout at(b);
+
+  PrimeCandidate c;
+  c.heuristics.pbs_gc = load_f64(b + at.pbs_gc + 8 * index);
+  c.heuristics.rtt_gc = load_f64(b + at.rtt_gc + 8 * index);
+  c.heuristics.edit_distance_from_nick = load_i32(b + at.edit_distance + 4 * index);
+  const uint8_t f = b[at.flags + index];
+  c.heuristics.flag_pbs_gc_extreme = (f & kPbsGcExtreme) != 0;
+  c.heuristics.flag_edit_far = (f & kEditFar) != 0;
+
+  c.peg.spacer = spacer(b, load_u32(b + at.spacer_id + 4 * index));
+  c.peg.cut_index = load_i32(b + at.cut_index + 4 * index);
+  if (f & kHasNgrna) {
+    c.ngrna = NickingSgRNA{spacer(b, load_u32(b + at.ngrna_spacer_id + 4 * index)),
+                           load_i32(b + at.ngrna_cut_index + 4 * index),
+                           (f & kNgrnaPe3b) != 0};
+  }
+
+  const size_t pbs_len = load_u16(b + at.pbs_len + 2 * index);
+  const size_t rtt_len = load_u16(b + at.rtt_len + 2 * index);
+  const uint64_t seq_offset = load_u32(b + at.seq_offset + 4 * index);
+  const uint64_t stored =
+      (f & kRawBases) ? pbs_len + rtt_len : (pbs_len + 3) / 4 + (rtt_len + 3) / 4;
+  if (seq_offset + stored > load_u32(b + 4)) malformed(path_);  // seq_bytes, checked by block()
+  const uint8_t *seq = b + at.seq + seq_offset;
+  if (f & kRawBases) {
+    c.peg.pbs.assign(reinterpret_cast<const char *>(seq), pbs_len);
+    c.peg.rtt.assign(reinterpret_cast<const char *>(seq + pbs_len), rtt_len);
+  } else {
+    unpack_2bit(seq, pbs_len, c.peg.pbs);
+    unpack_2bit(seq + (pbs_len + 3) / 4, rtt_len, c.peg.rtt);
+  }
+  return c;
+}
+
+CandidateList CandidateStore::candidates(size_t spec) const {
+  const size_t n = candidate_count(spec);
+  CandidateList out;
+  out.reserve(n);
+  for (size_t i = 0; i < n; ++i) out.push_back(candidate(spec, i));
+  return out;
+}
+
+CandidateStore design_prime_edits_spilled(const std::vector<PrimeEditSpec> &edits,
+                                          const DesignConfig &cfg, const std::string &path,
+                                          const SpillOptions &opts, const Device &device) {
+  AtomicFile out(path);
+  ByteWriter pending;
+  pending.raw(kStoreMagic);
+  pending.u32(kStoreVersion);
+
+  // Block offsets (8 bytes per spec) are the only state kept across the whole run.
+  std::vector<uint64_t> block_offsets;
+  block_offsets.reserve(edits.size());
+  for (const auto &spec : edits) {
+    block_offsets.push_back(out.bytes_written() + pending.bytes().size());
+    encode_block(pending, design_prime_edit(spec, cfg, device));
+    if (pending.bytes().size() >= opts.memory_budget_bytes) {
+      out.write(pending.bytes());
+      pending.clear();
+    }
+  }
+
+  const uint64_t index_offset = out.bytes_written() + pending.bytes().size();
+  for (uint64_t off : block_offsets) pending.u64(off);
+  pending.u64(edits.size());
+  pending.u64(index_offset);
+  pending.u32(kStoreVersion);
+  pending.raw(kStoreMagic);
+  out.write(pending.bytes());
+  out.commit();
+
+  return CandidateStore::open(path);
+}
+
+}  // namespace primeforge
@@ -0,0 +1,80 @@
+#include "io.hpp"
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+
+namespace primeforge {
+namespace fs = std::filesystem;
+
+void io_error(const std::string &what, const fs::path &path) {
+  throw std::runtime_error(what + " " + path.string() + ": " + std::strerror(errno));
+}
+
+AtomicFile::AtomicFile(fs::path path) : path_(std::move(path)) {
+  // mkstemp picks an unused name with O_EXCL, so writers on other hosts sharing the
+  // directory (where PIDs repeat, e.g. containers) never open each other's temp file.
+  std::string tmpl = path_.string() + ".tmp.XXXXXX";
+  fd_ = ::mkstemp(tmpl.data());
+  tmp_ = tmpl;
+  if (fd_ < 0) io_error("cannot create", tmp_);
+  if (::fchmod(fd_, 0644) != 0) {
+    const int err = errno;
+    ::close(fd_);
+    ::unlink(tmp_.c_str());
+    fd_ = -1;
+    errno = err;
+    io_error("cannot chmod", tmp_);
+  }
+}
+
+AtomicFile::~AtomicFile() {
+  if (fd_ >= 0) {
+    ::close(fd_);
+    ::unlink(tmp_.c_str());
+  }
+}
+
+void AtomicFile::write(std::string_view bytes) {
+  while (!bytes.empty()) {
+    const ssize_t n = ::write(fd_, bytes.data(), bytes.size());
+    if (n < 0) {
+      if (errno == EINTR) continue;
+      io_error("cannot write", tmp_);
+    }
+    bytes.remove_prefix(static_cast<size_t>(n));
+    written_ += static_cast<size_t>(n);
+  }
+}
+
+void AtomicFile::commit() {
+  if (::fsync(fd_) != 0) io_error("cannot fsync", tmp_);
+  const int rc = ::close(fd_);
+  fd_ = -1;
+  if (rc != 0) io_error("cannot close", tmp_);
+  if (std::rename(tmp_.c_str(), path_.c_str()) != 0) io_error("cannot rename", tmp_);
+}
+
+void write_file_atomic(const fs::path &path, std::string_view bytes) {
+  AtomicFile f(path);
+  f.write(bytes);
+  f.commit();
+}
+
+std::string read_file(const fs::path &path) {
+  std::ifstream in(path, std::ios::binary);
+  if (!in) io_error("cannot open", path);
+  std::ostringstream ss;
+  ss << in.rdbuf();
+  return ss.str();
+}
+
+}  // namespace primeforge
@@ -0,0 +1,39 @@
+#pragma once
+
+// Internal POSIX file helpers for the batch library.
+
+#include <filesystem>
+#include <string>
+#include <string_view>
+
+namespace primeforge {
+
+// Throws std::runtime_error("<what> <path>: <strerror(errno)>").
+[[noreturn]] void io_error(const std::string &what, const std::filesystem::path &path);
+
+// Writes to a unique <path>.tmp.XXXXXX (mkstemp) and renames over <path> on commit, so
+// readers only ever see complete files, even with concurrent writers of the same path.
+// Uncommitted temp files are removed on destruction.
+class AtomicFile {
+ public:
+  explicit AtomicFile(std::filesystem::path path);
+  AtomicFile(const AtomicFile &) = delete;
+  AtomicFile &operator=(const AtomicFile &) = delete;
+  ~AtomicFile();
+
+  void write(std::string_view bytes);
+  void commit();
+
+  size_t bytes_written() const { return written_; }
+
+ private:
+  std::filesystem::path path_;
+  std::filesystem::path tmp_;
+  int fd_{-1};
+  size_t written_{0};
+};
+
+void write_file_atomic(const std::filesystem::path &path, std::string_view bytes);
+std::string read_file(const std::filesystem::path &path);
+
+}  // namespace primeforge
@@ -0,0 +1,220 @@
+#include "serialize.hpp"
+
+#include <cstring>
+#include <stdexcept>
+
+namespace primeforge {
+namespace {
+
+enum EditTag : uint8_t { kSubstitution = 0, kInsertion = 1, kDeletion = 2 };
+
+}  // namespace
+
+uint64_t fnv1a64(std::string_view bytes, uint64_t hash) {
+  for (unsigned char c : bytes) {
+    hash ^= c;
+    hash *= 0x100000001b3ULL;
+  }
+  return hash;
+}
+
+void ByteWriter::u16(uint16_t v) {
+  buf_.push_back(static_cast<char>(v & 0xFF));
+  buf_.push_back(static_cast<char>(v >> 8));
+}
+
+void ByteWriter::u32(uint32_t v) {
+  for (int i = 0; i < 4; ++i) buf_.push_back(static_cast<char>((v >> (8 * i)) & 0xFF));
+}
+
+void ByteWriter::u64(uint64_t v) {
+  for (int i = 0; i < 8; ++i) buf_.push_back(static_cast<char>((v >> (8 * i)) & 0xFF));
+}
+
+void ByteWriter::f64(double v) {
+  uint64_t bits = 0;
+  std::memcpy(&bits, &v, sizeof(bits));
+  u64(bits);
+}
+
+void ByteWriter::str(std::string_view s) {
+  u32(static_cast<uint32_t>(s.size()));
+  buf_.append(s);
+}
+
+void ByteReader::need(size_t n) const {
+  if (n > remaining()) throw std::runtime_error("batch file truncated");
+}
+
+uint8_t ByteReader::u8() {
+  need(1);
+  return static_cast<uint8_t>(bytes_[pos_++]);
+}
+
+uint32_t ByteReader::u32() {
+  need(4);
+  uint32_t v = 0;
+  for (int i = 0; i < 4; ++i) v |= static_cast<uint32_t>(static_cast<uint8_t>(bytes_[pos_++])) << (8 * i);
+  return v;
+}
+
+uint64_t ByteReader::u64() {
+  need(8);
+  uint64_t v = 0;
+  for (int i = 0; i < 8; ++i) v |= static_cast<uint64_t>(static_cast<uint8_t>(bytes_[pos_++])) << (8 * i);
+  return v;
+}
+
+double ByteReader::f64() {
+  const uint64_t bits = u64();
+  double v = 0.0;
+  std::memcpy(&v, &bits, sizeof(v));
+  return v;
+}
+
+std::string ByteReader::str() {
+  const uint32_t n = u32();
+  return std::string(raw(n));
+}
+
+std::string_view ByteReader::raw(size_t n) {
+  need(n);
+  std::string_view out = bytes_.substr(pos_, n);
+  pos_ += n;
+  return out;
+}
+
+void encode_config(ByteWriter &w, const DesignConfig &cfg) {
+  w.i32(cfg.pbs_min_len);
+  w.i32(cfg.pbs_max_len);
+  w.i32(cfg.rtt_min_len);
+  w.i32(cfg.rtt_max_len);
+  w.i32(cfg.max_nick_to_edit_distance);
+  w.u32(static_cast<uint32_t>(cfg.pam_motifs.size()));
+  for (const auto &m : cfg.pam_motifs) w.str(m);
+  w.u8(cfg.design_ngrna ? 1 : 0);
+}
+
+DesignConfig decode_config(ByteReader &r) {
+  DesignConfig cfg;
+  cfg.pbs_min_len = r.i32();
+  cfg.pbs_max_len = r.i32();
+  cfg.rtt_min_len = r.i32();
+  cfg.rtt_max_len = r.i32();
+  cfg.max_nick_to_edit_distance = r.i32();
+  cfg.pam_motifs.resize(r.u32());
+  for (auto &m : cfg.pam_motifs) m = r.str();
+  cfg.design_ngrna = r.u8() != 0;
+  return cfg;
+}
+
+void encode_spec(ByteWriter &w, const PrimeEditSpec &spec) {
+  w.str(spec.id);
+  w.str(spec.ref_sequence);
+  w.u8(spec.strand == Strand::Minus ? 1 : 0);
+  w.u32(static_cast<uint32_t>(spec.edits.size()));
+  for (const auto &ev : spec.edits) {
+    if (std::holds_alternative<EditSubstitution>(ev)) {
+      const auto &e = std::get<EditSubstitution>(ev);
+      w.u8(kSubstitution);
+      w.i32(e.pos);
+      w.u8(static_cast<uint8_t>(e.ref));
+      w.u8(static_cast<uint8_t>(e.alt));
+    } else if (std::holds_alternative<EditInsertion>(ev)) {
+      const auto &e = std::get<EditInsertion>(ev);
+      w.u8(kInsertion);
+      w.i32(e.pos);
+      w.str(e.inserted);
+    } else {
+      const auto &e = std::get<EditDeletion>(ev);
+      w.u8(kDeletion);
+      w.i32(e.start);
+      w.i32(e.length);
+    }
+  }
+}
+
+PrimeEditSpec decode_spec(ByteReader &r) {
+  PrimeEditSpec spec;
+  spec.id = r.str();
+  spec.ref_sequence = r.str();
+  spec.strand = r.u8() ? Strand::Minus : Strand::Plus;
+  const uint32_t n = r.u32();
+  spec.edits.reserve(n);
+  for (uint32_t i = 0; i < n; ++i) {
+    switch (r.u8()) {
+      case kSubstitution: {
+        EditSubstitution e;
+        e.pos = r.i32();
+        e.ref = static_cast<char>(r.u8());
+        e.alt = static_cast<char>(r.u8());
+        spec.edits.emplace_back(e);
+        break;
+      }
+      case kInsertion: {
+        EditInsertion e;
+        e.pos = r.i32();
+        e.inserted = r.str();
+        spec.edits.emplace_back(std::move(e));
+        break;
+      }
+      case kDeletion: {
+        EditDeletion e;
+        e.start = r.i32();
+        e.length = r.i32();
+        spec.edits.emplace_back(e);
+        break;
+      }
+      default:
+        throw std::runtime_error("batch file has unknown edit tag");
+    }
+  }
+  return spec;
+}
+
+void encode_candidates(ByteWriter &w, const CandidateList &cands) {
+  w.u32(static_cast<uint32_t>(cands.size()));
+  for (const auto &c : cands) {
+    w.str(c.peg.spacer);
+    w.i32(c.peg.cut_index);
+    w.str(c.peg.pbs);
+    w.str(c.peg.rtt);
+    w.u8(c.ngrna.has_value() ? 1 : 0);
+    if (c.ngrna) {
+      w.str(c.ngrna->spacer);
+      w.i32(c.ngrna->cut_index);
+      w.u8(c.ngrna->is_pe3b ? 1 : 0);
+    }
+    w.f64(c.heuristics.pbs_gc);
+    w.f64(c.heuristics.rtt_gc);
+    w.i32(c.heuristics.edit_distance_from_nick);
+    w.u8(static_cast<uint8_t>((c.heuristics.flag_pbs_gc_extreme ? 1 : 0) |
+                              (c.heuristics.flag_edit_far ? 2 : 0)));
+  }
+}
+
+CandidateList decode_candidates(ByteReader &r) {
+  CandidateList cands(r.u32());
+  for (auto &c : cands) {
+    c.peg.spacer = r.str();
+    c.peg.cut_index = r.i32();
+    c.peg.pbs = r.str();
+    c.peg.rtt = r.str();
+    if (r.u8()) {
+      NickingSgRNA ng;
+      ng.spacer = r.str();
+      ng.cut_index = r.i32();
+      ng.is_pe3b = r.u8() != 0;
+      c.ngrna = std::move(ng);
+    }
+    c.heuristics.pbs_gc = r.f64();
+    c.heuristics.rtt_gc = r.f64();
+    c.heuristics.edit_distance_from_nick = r.i32();
+    const uint8_t flags = r.u8();
+    c.heuristics.flag_pbs_gc_extreme = (flags & 1) != 0;
+    c.heuristics.flag_edit_far = (flags & 2) != 0;
+  }
+  return cands;
+}
+
+}  // namespace primeforge
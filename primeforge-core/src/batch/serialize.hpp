@@ -0,0 +1,70 @@
+#pragma once
+
+// Internal binary encoding shared by the batch shard files. All integers are
+// little-endian fixed width; doubles are stored as their IEEE-754 bit pattern so a
+// record encodes to the same bytes regardless of which process produced it.
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <utility>
+
+#include "primeforge/types.hpp"
+
+namespace primeforge {
+
+uint64_t fnv1a64(std::string_view bytes, uint64_t hash = 0xcbf29ce484222325ULL);
+
+class ByteWriter {
+ public:
+  void u8(uint8_t v) { buf_.push_back(static_cast<char>(v)); }
+  void u16(uint16_t v);
+  void u32(uint32_t v);
+  void u64(uint64_t v);
+  void i32(int32_t v) { u32(static_cast<uint32_t>(v)); }
+  void f64(double v);
+  void str(std::string_view s);
+  void raw(std::string_view s) { buf_.append(s); }
+
+  const std::string &bytes() const { return buf_; }
+  std::string take() { return std::move(buf_); }
+  void clear() { buf_.clear(); }  // keeps capacity for reuse
+
+ private:
+  std::string buf_;
+};
+
+// Bounds-checked reader; throws std::runtime_error on truncated input.
+class ByteReader {
+ public:
+  explicit ByteReader(std::string_view bytes) : bytes_(bytes) {}
+
+  uint8_t u8();
+  uint32_t u32();
+  uint64_t u64();
+  int32_t i32() { return static_cast<int32_t>(u32()); }
+  double f64();
+  std::string str();
+  std::string_view raw(size_t n);
+
+  size_t pos() const { return pos_; }
+  size_t remaining() const { return bytes_.size() - pos_; }
+
+ private:
+  void need(size_t n) const;
+
+  std::string_view bytes_;
+  size_t pos_{0};
+};
+
+void encode_config(ByteWriter &w, const DesignConfig &cfg);
+DesignConfig decode_config(ByteReader &r);
+
+void encode_spec(ByteWriter &w, const PrimeEditSpec &spec);
+PrimeEditSpec decode_spec(ByteReader &r);
+
+// One spec's candidates: u32 count followed by each candidate.
+void encode_candidates(ByteWriter &w, const CandidateList &cands);
+CandidateList decode_candidates(ByteReader &r);
+
+}  // namespace primeforge
@@ -0,0 +1,129 @@
+#include "seq_kernels.hpp"
+
+#include <array>
+#include <cstdlib>
+#include <string>
+
+namespace primeforge {
+namespace {
+
+constexpr std::array<char, 256> make_complement_table() {
+  std::array<char, 256> t{};
+  for (auto &c : t) c = 'N';
+  t['A'] = t['a'] = 'T';
+  t['C'] = t['c'] = 'G';
+  t['G'] = t['g'] = 'C';
+  t['T'] = t['t'] = 'A';
+  return t;
+}
+
+constexpr std::array<char, 256> kComplement = make_complement_table();
+
+// Low-nibble code shared with the SIMD shuffles: A=1, C=3, G=7, T=4 in both cases.
+constexpr std::array<uint8_t, 16> kPackNibble = {0, 0, 0, 1, 3, 0, 0, 2, 0, 0, 0, 0, 0, 0, 0, 0};
+
+void rc_scalar(const char *in, size_t n, char *out) {
+  for (size_t i = 0; i < n; ++i) {
+    out[i] = kComplement[static_cast<unsigned char>(in[n - 1 - i])];
+  }
+}
+
+BaseCounts count_gc_n_scalar(const char *seq, size_t n) {
+  BaseCounts counts;
+  for (size_t i = 0; i < n; ++i) {
+    const char u = static_cast<char>(seq[i] & 0xDF);
+    counts.gc += (u == 'G' || u == 'C');
+    counts.n += (u == 'N');
+  }
+  return counts;
+}
+
+void to_upper_scalar(const char *in, size_t n, char *out) {
+  for (size_t i = 0; i < n; ++i) {
+    const char c = in[i];
+    out[i] = (c >= 'a' && c <= 'z') ? static_cast<char>(c - 0x20) : c;
+  }
+}
+
+size_t find_non_acgt_scalar(const char *seq, size_t n) {
+  for (size_t i = 0; i < n; ++i) {
+    const char u = static_cast<char>(seq[i] & 0xDF);
+    if (u != 'A' && u != 'C' && u != 'G' && u != 'T') return i;
+  }
+  return n;
+}
+
+void pack_2bit_scalar(const char *seq, size_t n, uint8_t *out) {
+  for (size_t byte = 0; byte < (n + 3) / 4; ++byte) {
+    uint8_t packed = 0;
+    for (size_t j = 0; j < 4 && byte * 4 + j < n; ++j) {
+      packed |= static_cast<uint8_t>(kPackNibble[seq[byte * 4 + j] & 0x0F] << (2 * j));
+    }
+    out[byte] = packed;
+  }
+}
+
+bool cpu_supports(SimdLevel level) {
+#ifdef PRIMEFORGE_HAVE_X86_SIMD
+  switch (level) {
+    case SimdLevel::Scalar: return true;
+    case SimdLevel::SSE42:
+      return __builtin_cpu_supports("sse4.2") && __builtin_cpu_supports("popcnt");
+    case SimdLevel::AVX2:
+      return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("popcnt");
+    case SimdLevel::AVX512:
+      return __builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw");
+  }
+  return false;
+#else
+  return level == SimdLevel::Scalar;
+#endif
+}
+
+const SeqKernels &select_kernels() {
+  const SimdLevel cap = parse_simd_level(std::getenv("PRIMEFORGE_SIMD"));
+  for (SimdLevel level : {SimdLevel::AVX512, SimdLevel::AVX2, SimdLevel::SSE42}) {
+    if (level > cap) continue;
+    if (const SeqKernels *k = seq_kernels_for(level)) return *k;
+  }
+  return seq_kernels_scalar();
+}
+
+}  // namespace
+
+const SeqKernels &seq_kernels_scalar() {
+  static const SeqKernels kernels{SimdLevel::Scalar,  "scalar",
+                                  rc_scalar,          count_gc_n_scalar,
+                                  to_upper_scalar,    find_non_acgt_scalar,
+                                  pack_2bit_scalar};
+  return kernels;
+}
+
+SimdLevel parse_simd_level(const char *value) {
+  if (!value || !*value) return SimdLevel::AVX512;
+  const std::string v(value);
+  if (v == "sse4.2" || v == "sse42") return SimdLevel::SSE42;
+  if (v == "avx2") return SimdLevel::AVX2;
+  if (v == "avx512") return SimdLevel::AVX512;
+  return SimdLevel::Scalar;  // "scalar" and unrecognized values
+}
+
+const SeqKernels *seq_kernels_for(SimdLevel level) {
+  if (!cpu_supports(level)) return nullptr;
+  switch (level) {
+    case SimdLevel::Scalar: return &seq_kernels_scalar();
+#ifdef PRIMEFORGE_HAVE_X86_SIMD
+    case SimdLevel::SSE42: return &seq_kernels_sse42();
+    case SimdLevel::AVX2: return &seq_kernels_avx2();
+    case SimdLevel::AVX512: return &seq_kernels_avx512();
+#endif
+    default: return nullptr;
+  }
+}
+
+const SeqKernels &seq_kernels() {
+  static const SeqKernels &kernels = select_kernels();
+  return kernels;
+}
+
+}  // namespace primeforge
@@ -0,0 +1,53 @@
+#pragma once
+
+// Internal sequence kernels with runtime CPU dispatch. Keep this header free of
+// inline library code: it is included by translation units compiled with ISA flags
+// (-mavx2 etc.), and inline definitions emitted there could leak into scalar callers.
+
+#include <cstddef>
+#include <cstdint>
+
+namespace primeforge {
+
+enum class SimdLevel { Scalar, SSE42, AVX2, AVX512 };
+
+struct BaseCounts {
+  size_t gc{0};  // G/C, either case
+  size_t n{0};   // N, either case
+};
+
+struct SeqKernels {
+  SimdLevel level;
+  const char *name;
+  // out[i] = complement(in[n - 1 - i]); non-ACGT maps to 'N'. out must not alias in.
+  void (*reverse_complement)(const char *in, size_t n, char *out);
+  BaseCounts (*count_gc_n)(const char *seq, size_t n);
+  // ASCII a-z -> A-Z, other bytes unchanged. out may alias in.
+  void (*to_upper)(const char *in, size_t n, char *out);
+  // Index of the first byte outside ACGTacgt, or n if all are valid.
+  size_t (*find_non_acgt)(const char *seq, size_t n);
+  // A/C/G/T (either case) -> 0/1/2/3, four bases per byte, base i in bits 2*(i%4).
+  // Writes (n + 3) / 4 bytes; unused high bits of the last byte are zero. Bytes
+  // outside ACGTacgt pack to an unspecified (but level-independent) code.
+  void (*pack_2bit)(const char *seq, size_t n, uint8_t *out);
+};
+
+// Cap from a PRIMEFORGE_SIMD value. Accepted: "scalar", "sse4.2" (or "sse42"), "avx2",
+// "avx512"; unset or empty means no cap. Anything else caps at Scalar, so a typo never
+// raises the level.
+SimdLevel parse_simd_level(const char *value);
+
+// Best level supported by this CPU, capped by parse_simd_level(getenv("PRIMEFORGE_SIMD")).
+const SeqKernels &seq_kernels();
+
+// Kernels for a specific level, or nullptr if not compiled in or unsupported by the CPU.
+const SeqKernels *seq_kernels_for(SimdLevel level);
+
+const SeqKernels &seq_kernels_scalar();
+#ifdef PRIMEFORGE_HAVE_X86_SIMD
+const SeqKernels &seq_kernels_sse42();
+const SeqKernels &seq_kernels_avx2();
+const SeqKernels &seq_kernels_avx512();
+#endif
+
+}  // namespace primeforge
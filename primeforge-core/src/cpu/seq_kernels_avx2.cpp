@@ -0,0 +1,110 @@
+#include <immintrin.h>
+
+#include <cstring>
+
+#include "seq_kernels.hpp"
+
+namespace primeforge {
+namespace {
+
+inline __m256i upper_bits(__m256i v) {
+  return _mm256_and_si256(v, _mm256_set1_epi8(static_cast<char>(0xDF)));
+}
+
+inline __m256i complement32(__m256i v) {
+  const __m256i u = upper_bits(v);
+  __m256i out = _mm256_set1_epi8('N');
+  out = _mm256_blendv_epi8(out, _mm256_set1_epi8('T'), _mm256_cmpeq_epi8(u, _mm256_set1_epi8('A')));
+  out = _mm256_blendv_epi8(out, _mm256_set1_epi8('G'), _mm256_cmpeq_epi8(u, _mm256_set1_epi8('C')));
+  out = _mm256_blendv_epi8(out, _mm256_set1_epi8('C'), _mm256_cmpeq_epi8(u, _mm256_set1_epi8('G')));
+  out = _mm256_blendv_epi8(out, _mm256_set1_epi8('A'), _mm256_cmpeq_epi8(u, _mm256_set1_epi8('T')));
+  return out;
+}
+
+void rc_avx2(const char *in, size_t n, char *out) {
+  const __m256i rev = _mm256_setr_epi8(15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0,
+                                       15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0);
+  size_t i = 0;
+  for (; i + 32 <= n; i += 32) {
+    const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(in + n - i - 32));
+    // Reverse bytes within each 128-bit lane, then swap the lanes.
+    const __m256i r = _mm256_permute4x64_epi64(_mm256_shuffle_epi8(v, rev), 0x4E);
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(out + i), complement32(r));
+  }
+  seq_kernels_scalar().reverse_complement(in, n - i, out + i);
+}
+
+BaseCounts count_gc_n_avx2(const char *seq, size_t n) {
+  BaseCounts counts;
+  size_t i = 0;
+  for (; i + 32 <= n; i += 32) {
+    const __m256i u = upper_bits(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(seq + i)));
+    const __m256i gc = _mm256_or_si256(_mm256_cmpeq_epi8(u, _mm256_set1_epi8('G')),
+                                       _mm256_cmpeq_epi8(u, _mm256_set1_epi8('C')));
+    const __m256i nn = _mm256_cmpeq_epi8(u, _mm256_set1_epi8('N'));
+    counts.gc += _mm_popcnt_u32(static_cast<unsigned>(_mm256_movemask_epi8(gc)));
+    counts.n += _mm_popcnt_u32(static_cast<unsigned>(_mm256_movemask_epi8(nn)));
+  }
+  const BaseCounts tail = seq_kernels_scalar().count_gc_n(seq + i, n - i);
+  counts.gc += tail.gc;
+  counts.n += tail.n;
+  return counts;
+}
+
+void to_upper_avx2(const char *in, size_t n, char *out) {
+  size_t i = 0;
+  for (; i + 32 <= n; i += 32) {
+    const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(in + i));
+    const __m256i lower = _mm256_and_si256(_mm256_cmpgt_epi8(v, _mm256_set1_epi8('a' - 1)),
+                                           _mm256_cmpgt_epi8(_mm256_set1_epi8('z' + 1), v));
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(out + i),
+                        _mm256_xor_si256(v, _mm256_and_si256(lower, _mm256_set1_epi8(0x20))));
+  }
+  seq_kernels_scalar().to_upper(in + i, n - i, out + i);
+}
+
+size_t find_non_acgt_avx2(const char *seq, size_t n) {
+  size_t i = 0;
+  for (; i + 32 <= n; i += 32) {
+    const __m256i u = upper_bits(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(seq + i)));
+    const __m256i ok = _mm256_or_si256(
+        _mm256_or_si256(_mm256_cmpeq_epi8(u, _mm256_set1_epi8('A')),
+                        _mm256_cmpeq_epi8(u, _mm256_set1_epi8('C'))),
+        _mm256_or_si256(_mm256_cmpeq_epi8(u, _mm256_set1_epi8('G')),
+                        _mm256_cmpeq_epi8(u, _mm256_set1_epi8('T'))));
+    const unsigned bad = ~static_cast<unsigned>(_mm256_movemask_epi8(ok));
+    if (bad) return i + static_cast<size_t>(__builtin_ctz(bad));
+  }
+  return i + seq_kernels_scalar().find_non_acgt(seq + i, n - i);
+}
+
+void pack_2bit_avx2(const char *seq, size_t n, uint8_t *out) {
+  const __m256i table = _mm256_setr_epi8(0, 0, 0, 1, 3, 0, 0, 2, 0, 0, 0, 0, 0, 0, 0, 0,
+                                         0, 0, 0, 1, 3, 0, 0, 2, 0, 0, 0, 0, 0, 0, 0, 0);
+  const __m256i gather = _mm256_setr_epi8(0, 4, 8, 12, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+                                          0, 4, 8, 12, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1);
+  const __m256i lanes = _mm256_setr_epi32(0, 4, 0, 0, 0, 0, 0, 0);
+  size_t i = 0;
+  for (; i + 32 <= n; i += 32) {
+    const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(seq + i));
+    const __m256i codes = _mm256_shuffle_epi8(table, _mm256_and_si256(v, _mm256_set1_epi8(0x0F)));
+    __m256i x = _mm256_maddubs_epi16(codes, _mm256_set1_epi16(0x0401));
+    x = _mm256_madd_epi16(x, _mm256_set1_epi32(0x00100001));
+    x = _mm256_permutevar8x32_epi32(_mm256_shuffle_epi8(x, gather), lanes);
+    const long long packed = _mm_cvtsi128_si64(_mm256_castsi256_si128(x));
+    std::memcpy(out + i / 4, &packed, 8);
+  }
+  seq_kernels_scalar().pack_2bit(seq + i, n - i, out + i / 4);
+}
+
+}  // namespace
+
+const SeqKernels &seq_kernels_avx2() {
+  static const SeqKernels kernels{SimdLevel::AVX2,  "avx2",
+                                  rc_avx2,          count_gc_n_avx2,
+                                  to_upper_avx2,    find_non_acgt_avx2,
+                                  pack_2bit_avx2};
+  return kernels;
+}
+
+}  // namespace primeforge
@@ -0,0 +1,100 @@
+#include <immintrin.h>
+
+#include "seq_kernels.hpp"
+
+namespace primeforge {
+namespace {
+
+// Full-mask maskz forms of broadcast/shuffle/narrow: the unmasked GCC intrinsics seed
+// from _mm512_undefined and trip -Wuninitialized.
+inline __m512i broadcast_lane(__m128i v) { return _mm512_maskz_broadcast_i32x4(0xFFFF, v); }
+
+inline __m512i upper_bits(__m512i v) {
+  return _mm512_and_si512(v, _mm512_set1_epi8(static_cast<char>(0xDF)));
+}
+
+void rc_avx512(const char *in, size_t n, char *out) {
+  const __m512i rev = broadcast_lane(
+      _mm_setr_epi8(15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0));
+  size_t i = 0;
+  for (; i + 64 <= n; i += 64) {
+    const __m512i v = _mm512_loadu_si512(in + n - i - 64);
+    // Reverse bytes within each 128-bit lane, then reverse the lane order.
+    const __m512i r = _mm512_shuffle_epi8(v, rev);
+    const __m512i u = upper_bits(_mm512_maskz_shuffle_i64x2(0xFF, r, r, 0x1B));
+    __m512i c = _mm512_set1_epi8('N');
+    c = _mm512_mask_mov_epi8(c, _mm512_cmpeq_epi8_mask(u, _mm512_set1_epi8('A')), _mm512_set1_epi8('T'));
+    c = _mm512_mask_mov_epi8(c, _mm512_cmpeq_epi8_mask(u, _mm512_set1_epi8('C')), _mm512_set1_epi8('G'));
+    c = _mm512_mask_mov_epi8(c, _mm512_cmpeq_epi8_mask(u, _mm512_set1_epi8('G')), _mm512_set1_epi8('C'));
+    c = _mm512_mask_mov_epi8(c, _mm512_cmpeq_epi8_mask(u, _mm512_set1_epi8('T')), _mm512_set1_epi8('A'));
+    _mm512_storeu_si512(out + i, c);
+  }
+  seq_kernels_scalar().reverse_complement(in, n - i, out + i);
+}
+
+BaseCounts count_gc_n_avx512(const char *seq, size_t n) {
+  BaseCounts counts;
+  size_t i = 0;
+  for (; i + 64 <= n; i += 64) {
+    const __m512i u = upper_bits(_mm512_loadu_si512(seq + i));
+    const __mmask64 gc = _mm512_cmpeq_epi8_mask(u, _mm512_set1_epi8('G')) |
+                         _mm512_cmpeq_epi8_mask(u, _mm512_set1_epi8('C'));
+    counts.gc += _mm_popcnt_u64(gc);
+    counts.n += _mm_popcnt_u64(_mm512_cmpeq_epi8_mask(u, _mm512_set1_epi8('N')));
+  }
+  const BaseCounts tail = seq_kernels_scalar().count_gc_n(seq + i, n - i);
+  counts.gc += tail.gc;
+  counts.n += tail.n;
+  return counts;
+}
+
+void to_upper_avx512(const char *in, size_t n, char *out) {
+  size_t i = 0;
+  for (; i + 64 <= n; i += 64) {
+    const __m512i v = _mm512_loadu_si512(in + i);
+    const __mmask64 lower = _mm512_cmpge_epu8_mask(v, _mm512_set1_epi8('a')) &
+                            _mm512_cmple_epu8_mask(v, _mm512_set1_epi8('z'));
+    _mm512_storeu_si512(out + i, _mm512_mask_sub_epi8(v, lower, v, _mm512_set1_epi8(0x20)));
+  }
+  seq_kernels_scalar().to_upper(in + i, n - i, out + i);
+}
+
+size_t find_non_acgt_avx512(const char *seq, size_t n) {
+  size_t i = 0;
+  for (; i + 64 <= n; i += 64) {
+    const __m512i u = upper_bits(_mm512_loadu_si512(seq + i));
+    const __mmask64 ok = _mm512_cmpeq_epi8_mask(u, _mm512_set1_epi8('A')) |
+                         _mm512_cmpeq_epi8_mask(u, _mm512_set1_epi8('C')) |
+                         _mm512_cmpeq_epi8_mask(u, _mm512_set1_epi8('G')) |
+                         _mm512_cmpeq_epi8_mask(u, _mm512_set1_epi8('T'));
+    const unsigned long long bad = ~static_cast<unsigned long long>(ok);
+    if (bad) return i + static_cast<size_t>(__builtin_ctzll(bad));
+  }
+  return i + seq_kernels_scalar().find_non_acgt(seq + i, n - i);
+}
+
+void pack_2bit_avx512(const char *seq, size_t n, uint8_t *out) {
+  const __m512i table = broadcast_lane(
+      _mm_setr_epi8(0, 0, 0, 1, 3, 0, 0, 2, 0, 0, 0, 0, 0, 0, 0, 0));
+  size_t i = 0;
+  for (; i + 64 <= n; i += 64) {
+    const __m512i v = _mm512_loadu_si512(seq + i);
+    const __m512i codes = _mm512_shuffle_epi8(table, _mm512_and_si512(v, _mm512_set1_epi8(0x0F)));
+    __m512i x = _mm512_maddubs_epi16(codes, _mm512_set1_epi16(0x0401));
+    x = _mm512_madd_epi16(x, _mm512_set1_epi32(0x00100001));
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(out + i / 4), _mm512_maskz_cvtepi32_epi8(0xFFFF, x));
+  }
+  seq_kernels_scalar().pack_2bit(seq + i, n - i, out + i / 4);
+}
+
+}  // namespace
+
+const SeqKernels &seq_kernels_avx512() {
+  static const SeqKernels kernels{SimdLevel::AVX512,  "avx512",
+                                  rc_avx512,          count_gc_n_avx512,
+                                  to_upper_avx512,    find_non_acgt_avx512,
+                                  pack_2bit_avx512};
+  return kernels;
+}
+
+}  // namespace primeforge
@@ -0,0 +1,101 @@
+#include <immintrin.h>
+
+#include <cstring>
+
+#include "seq_kernels.hpp"
+
+namespace primeforge {
+namespace {
+
+inline __m128i upper_bits(__m128i v) { return _mm_and_si128(v, _mm_set1_epi8(static_cast<char>(0xDF))); }
+
+inline __m128i complement16(__m128i v) {
+  const __m128i u = upper_bits(v);
+  __m128i out = _mm_set1_epi8('N');
+  out = _mm_blendv_epi8(out, _mm_set1_epi8('T'), _mm_cmpeq_epi8(u, _mm_set1_epi8('A')));
+  out = _mm_blendv_epi8(out, _mm_set1_epi8('G'), _mm_cmpeq_epi8(u, _mm_set1_epi8('C')));
+  out = _mm_blendv_epi8(out, _mm_set1_epi8('C'), _mm_cmpeq_epi8(u, _mm_set1_epi8('G')));
+  out = _mm_blendv_epi8(out, _mm_set1_epi8('A'), _mm_cmpeq_epi8(u, _mm_set1_epi8('T')));
+  return out;
+}
+
+void rc_sse42(const char *in, size_t n, char *out) {
+  const __m128i rev = _mm_setr_epi8(15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0);
+  size_t i = 0;
+  for (; i + 16 <= n; i += 16) {
+    const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(in + n - i - 16));
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(out + i), complement16(_mm_shuffle_epi8(v, rev)));
+  }
+  seq_kernels_scalar().reverse_complement(in, n - i, out + i);
+}
+
+BaseCounts count_gc_n_sse42(const char *seq, size_t n) {
+  BaseCounts counts;
+  size_t i = 0;
+  for (; i + 16 <= n; i += 16) {
+    const __m128i u = upper_bits(_mm_loadu_si128(reinterpret_cast<const __m128i *>(seq + i)));
+    const __m128i gc = _mm_or_si128(_mm_cmpeq_epi8(u, _mm_set1_epi8('G')),
+                                    _mm_cmpeq_epi8(u, _mm_set1_epi8('C')));
+    const __m128i nn = _mm_cmpeq_epi8(u, _mm_set1_epi8('N'));
+    counts.gc += _mm_popcnt_u32(static_cast<unsigned>(_mm_movemask_epi8(gc)));
+    counts.n += _mm_popcnt_u32(static_cast<unsigned>(_mm_movemask_epi8(nn)));
+  }
+  const BaseCounts tail = seq_kernels_scalar().count_gc_n(seq + i, n - i);
+  counts.gc += tail.gc;
+  counts.n += tail.n;
+  return counts;
+}
+
+void to_upper_sse42(const char *in, size_t n, char *out) {
+  size_t i = 0;
+  for (; i + 16 <= n; i += 16) {
+    const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(in + i));
+    // Signed compares: bytes >= 0x80 are negative and never fall in [a, z].
+    const __m128i lower = _mm_and_si128(_mm_cmpgt_epi8(v, _mm_set1_epi8('a' - 1)),
+                                        _mm_cmplt_epi8(v, _mm_set1_epi8('z' + 1)));
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(out + i),
+                     _mm_xor_si128(v, _mm_and_si128(lower, _mm_set1_epi8(0x20))));
+  }
+  seq_kernels_scalar().to_upper(in + i, n - i, out + i);
+}
+
+size_t find_non_acgt_sse42(const char *seq, size_t n) {
+  size_t i = 0;
+  for (; i + 16 <= n; i += 16) {
+    const __m128i u = upper_bits(_mm_loadu_si128(reinterpret_cast<const __m128i *>(seq + i)));
+    const __m128i ok = _mm_or_si128(
+        _mm_or_si128(_mm_cmpeq_epi8(u, _mm_set1_epi8('A')), _mm_cmpeq_epi8(u, _mm_set1_epi8('C'))),
+        _mm_or_si128(_mm_cmpeq_epi8(u, _mm_set1_epi8('G')), _mm_cmpeq_epi8(u, _mm_set1_epi8('T'))));
+    const unsigned bad = ~static_cast<unsigned>(_mm_movemask_epi8(ok)) & 0xFFFFu;
+    if (bad) return i + static_cast<size_t>(__builtin_ctz(bad));
+  }
+  return i + seq_kernels_scalar().find_non_acgt(seq + i, n - i);
+}
+
+void pack_2bit_sse42(const char *seq, size_t n, uint8_t *out) {
+  const __m128i table = _mm_setr_epi8(0, 0, 0, 1, 3, 0, 0, 2, 0, 0, 0, 0, 0, 0, 0, 0);
+  const __m128i gather = _mm_setr_epi8(0, 4, 8, 12, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1);
+  size_t i = 0;
+  for (; i + 16 <= n; i += 16) {
+    const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(seq + i));
+    const __m128i codes = _mm_shuffle_epi8(table, _mm_and_si128(v, _mm_set1_epi8(0x0F)));
+    // Pairs -> c0 + 4*c1, then quads -> p0 + 16*p1, leaving one packed byte per dword.
+    __m128i x = _mm_maddubs_epi16(codes, _mm_set1_epi16(0x0401));
+    x = _mm_madd_epi16(x, _mm_set1_epi32(0x00100001));
+    const int packed = _mm_cvtsi128_si32(_mm_shuffle_epi8(x, gather));
+    std::memcpy(out + i / 4, &packed, 4);
+  }
+  seq_kernels_scalar().pack_2bit(seq + i, n - i, out + i / 4);
+}
+
+}  // namespace
+
+const SeqKernels &seq_kernels_sse42() {
+  static const SeqKernels kernels{SimdLevel::SSE42,  "sse4.2",
+                                  rc_sse42,          count_gc_n_sse42,
+                                  to_upper_sse42,    find_non_acgt_sse42,
+                                  pack_2bit_sse42};
+  return kernels;
+}
+
+}  // namespace primeforge
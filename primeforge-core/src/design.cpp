@@ -3,99 +3,24 @@
 #include <algorithm>
 #include <cmath>
 #include <limits>
+#include <optional>
 #include <string>
 
+#include "design_state.hpp"
 #include "primeforge/pam.hpp"
 #include "primeforge/utils.hpp"
 
 namespace primeforge {
 namespace {
 
-struct EditBounds {
-  int start{0};
-  int end{0}; // exclusive
-};
-
-struct PamHit {
-  size_t pam_idx{0};  // start index in seq_view
-  bool is_reverse{false};
-};
-
-struct MotifHit {
-  PamHit hit;
-  std::string motif;
-};
-
-EditBounds bounds_for_edit(const EditVariant &edit) {
-  if (std::holds_alternative<EditSubstitution>(edit)) {
-    const auto &e = std::get<EditSubstitution>(edit);
-    return {e.pos, e.pos + 1};
-  }
-  if (std::holds_alternative<EditInsertion>(edit)) {
-    const auto &e = std::get<EditInsertion>(edit);
-    return {e.pos, e.pos};
-  }
-  const auto &e = std::get<EditDeletion>(edit);
-  return {e.start, e.start + e.length};
-}
-
-int first_edit_pos(const PrimeEditSpec &spec) {
-  if (spec.edits.empty()) return 0;
-  int min_pos = std::numeric_limits<int>::max();
-  for (const auto &ev : spec.edits) {
-    min_pos = std::min(min_pos, bounds_for_edit(ev).start);
-  }
-  return min_pos == std::numeric_limits<int>::max() ? 0 : min_pos;
-}
-
-std::string apply_edits(const PrimeEditSpec &spec) {
-  std::string seq = spec.ref_sequence;
-  // Apply edits in position order for determinism.
-  std::vector<std::pair<int, EditVariant>> ordered;
-  ordered.reserve(spec.edits.size());
-  for (const auto &e : spec.edits) {
-    ordered.emplace_back(bounds_for_edit(e).start, e);
-  }
-  std::sort(ordered.begin(), ordered.end(), [](const auto &a, const auto &b) {
-    return a.first < b.first;
-  });
-
-  int offset = 0;  // track length delta to keep positions consistent
-  for (const auto &[_, edit] : ordered) {
-    if (std::holds_alternative<EditSubstitution>(edit)) {
-      const auto &e = std::get<EditSubstitution>(edit);
-      int idx = e.pos + offset;
-      if (idx >= 0 && idx < static_cast<int>(seq.size())) {
-        seq[idx] = e.alt;
-      }
-    } else if (std::holds_alternative<EditInsertion>(edit)) {
-      const auto &e = std::get<EditInsertion>(edit);
-      int idx = e.pos + offset;
-      if (idx >= 0 && idx <= static_cast<int>(seq.size())) {
-        seq.insert(idx, e.inserted);
-        offset += static_cast<int>(e.inserted.size());
-      }
-    } else if (std::holds_alternative<EditDeletion>(edit)) {
-      const auto &e = std::get<EditDeletion>(edit);
-      int idx = e.start + offset;
-      if (idx >= 0 && idx + e.length <= static_cast<int>(seq.size())) {
-        seq.erase(idx, e.length);
-        offset -= e.length;
-      }
-    }
-  }
-  return seq;
-}
-
-std::vector<PamHit> collect_pam_hits(const std::string &seq_view, const std::string &motif,
+std::vector<PamHit> collect_pam_hits(const SpecState &st, const std::string &motif,
                                      const Device &device) {
   std::vector<PamHit> hits;
-  auto plus_hits = find_pam_sites(seq_view, motif, device);
+  auto plus_hits = find_pam_sites(st.seq_view, motif, device);
   for (auto h : plus_hits) hits.push_back(PamHit{h, false});
 
-  std::string rc = reverse_complement(seq_view);
-  auto rev_hits = find_pam_sites(rc, motif, device);
-  const int L = static_cast<int>(seq_view.size());
+  auto rev_hits = find_pam_sites(st.seq_view_rc, motif, device);
+  const int L = static_cast<int>(st.seq_view.size());
   for (auto h_rc : rev_hits) {
     size_t mapped = static_cast<size_t>(L - (static_cast<int>(h_rc) + static_cast<int>(motif.size())));
     hits.push_back(PamHit{mapped, true});
@@ -103,125 +28,167 @@ std::vector<PamHit> collect_pam_hits(const std::string &seq_view, const std::str
   return hits;
 }
 
-}  // namespace
+// Scan one motif on both strands and keep every site a config could use.
+MotifScan &scan_motif(SpecState &st, const std::string &motif, const Device &device,
+                      DesignSessionStats &stats) {
+  auto it = st.scans.find(motif);
+  if (it != st.scans.end()) return it->second;
 
-CandidateList design_prime_edit(const PrimeEditSpec &edit, const DesignConfig &cfg,
-                                const Device &device) {
-  CandidateList out;
+  MotifScan scan;
+  const int motif_len = static_cast<int>(motif.size());
+  const int view_len = static_cast<int>(st.seq_view.size());
+  const Strand strand = st.reverse ? Strand::Minus : Strand::Plus;
+  for (const auto &hit : collect_pam_hits(st, motif, device)) {
+    scan.has_hit = true;
+    scan.has_reverse_hit |= hit.is_reverse;
 
-  const bool reverse = (edit.strand == Strand::Minus);
-  const int seq_len = static_cast<int>(edit.ref_sequence.size());
-
-  // Map edit positions into the working orientation.
-  const auto map_pos_view = [&](int pos) {
-    return reverse ? (seq_len - 1 - pos) : pos;
-  };
-
-  const int edit_start_orig = first_edit_pos(edit);
-
-  int edit_min_view = std::numeric_limits<int>::max();
-  int edit_max_view = std::numeric_limits<int>::min();
-  for (const auto &ev : edit.edits) {
-    const auto b = bounds_for_edit(ev);
-    int s = map_pos_view(b.start);
-    int endpoint = (b.end > b.start) ? (b.end - 1) : b.start;
-    int e = map_pos_view(endpoint);  // inclusive endpoint
-    edit_min_view = std::min({edit_min_view, s, e});
-    edit_max_view = std::max({edit_max_view, s, e});
-  }
-  if (edit_min_view == std::numeric_limits<int>::max()) {
-    edit_min_view = edit_max_view = 0;
-  }
+    int spacer_start = hit.is_reverse ? static_cast<int>(hit.pam_idx) + motif_len
+                                      : static_cast<int>(hit.pam_idx) - 20;
+    if (spacer_start < 0) continue;
+    if (spacer_start + 20 > view_len) continue;
 
-  std::string seq_view = reverse ? reverse_complement(edit.ref_sequence) : edit.ref_sequence;
-  std::string edited_view =
-      reverse ? reverse_complement(apply_edits(edit)) : apply_edits(edit);
+    const int cut_view = spacer_start + 17;  // 3bp upstream of PAM relative to spacer start
+    const int cut_out = st.reverse ? (st.seq_len - 1 - cut_view) : cut_view;
+    std::string spacer = st.seq_view.substr(spacer_start, 20);
 
-  std::vector<MotifHit> all_hits;
-  for (const auto &motif : cfg.pam_motifs) {
-    auto pam_hits = collect_pam_hits(seq_view, motif, device);
-    for (const auto &h : pam_hits) {
-      all_hits.push_back(MotifHit{h, motif});
+    // pegRNA should align to the working orientation (non-reverse hits).
+    if (!hit.is_reverse) {
+      NickSite nick;
+      nick.spacer_start = spacer_start;
+      nick.cut_view = cut_view;
+      nick.cut_out = cut_out;
+      // The nick is the boundary before cut_view; upstream indels shift it in the edited
+      // view, and an insertion anchored at the nick is the start of the RTT template.
+      nick.cut_edit = st.edited.lift.to_edited_left(cut_view, strand);
+      nick.spacer = spacer;
+      scan.nicks.push_back(std::move(nick));
     }
+    scan.ng_sites.push_back(NgSite{hit.is_reverse, cut_out, std::move(spacer)});
   }
+  ++stats.pam_scans;
+  return st.scans.emplace(motif, std::move(scan)).first->second;
+}
 
-  // Pre-filter reverse hits for possible ngRNAs.
-  std::vector<MotifHit> reverse_hits;
-  reverse_hits.reserve(all_hits.size());
-  for (const auto &mh : all_hits) {
-    if (mh.hit.is_reverse) reverse_hits.push_back(mh);
+const SeqPiece &pbs_piece(const SpecState &st, NickSite &nick, int len,
+                          DesignSessionStats &stats) {
+  if (nick.pbs.size() <= static_cast<size_t>(len)) nick.pbs.resize(len + 1);
+  auto &slot = nick.pbs[len];
+  if (!slot) {
+    std::string pbs = reverse_complement(st.seq_view.substr(nick.cut_view - len, len));
+    const double gc = gc_content(pbs);
+    slot = SeqPiece{std::move(pbs), gc};
+    ++stats.pbs_built;
   }
-  const std::vector<MotifHit> &ngrna_pool = !reverse_hits.empty() ? reverse_hits : all_hits;
+  return *slot;
+}
 
-  for (const auto &mh : all_hits) {
-    const auto &hit = mh.hit;
-    const int motif_len = static_cast<int>(mh.motif.size());
-    // pegRNA should align to the working orientation (non-reverse hits).
-    if (hit.is_reverse) continue;
+const SeqPiece &rtt_piece(const SpecState &st, NickSite &nick, int len,
+                          DesignSessionStats &stats) {
+  if (nick.rtt.size() <= static_cast<size_t>(len)) nick.rtt.resize(len + 1);
+  auto &slot = nick.rtt[len];
+  if (!slot) {
+    std::string rtt = st.edited_view.substr(nick.cut_edit, len);
+    const double gc = gc_content(rtt);
+    slot = SeqPiece{std::move(rtt), gc};
+    ++stats.rtt_built;
+  }
+  return *slot;
+}
 
-    int spacer_start = hit.is_reverse ? static_cast<int>(hit.pam_idx) + motif_len
-                                      : static_cast<int>(hit.pam_idx) - 20;
-    if (spacer_start < 0) continue;
-    if (spacer_start + 20 > static_cast<int>(seq_view.size())) continue;
-
-    int cut_index_view = spacer_start + 17;  // 3bp upstream of PAM relative to spacer start
-    if (cut_index_view < 0 || cut_index_view >= static_cast<int>(seq_view.size())) continue;
-
-    int cut_index_out =
-        reverse ? (seq_len - 1 - cut_index_view) : cut_index_view;
-
-    // Ensure edit within allowable distance using original coordinates.
-    int distance = std::abs(cut_index_out - edit_start_orig);
-    bool edit_far = distance > cfg.max_nick_to_edit_distance;
-
-    // Optional companion ngRNA (PE3/PE3b): pick closest opposite-strand PAM.
-    std::optional<NickingSgRNA> ngrna;
-    if (cfg.design_ngrna && !ngrna_pool.empty()) {
-      int best_dist = std::numeric_limits<int>::max();
-      for (const auto &ng_hit : ngrna_pool) {
-        const int ng_motif_len = static_cast<int>(ng_hit.motif.size());
-        int ng_spacer_start = ng_hit.hit.is_reverse
-                                  ? static_cast<int>(ng_hit.hit.pam_idx) + ng_motif_len
-                                  : static_cast<int>(ng_hit.hit.pam_idx) - 20;
-        if (ng_spacer_start < 0) continue;
-        if (ng_spacer_start + 20 > static_cast<int>(seq_view.size())) continue;
-        int ng_cut_view = ng_spacer_start + 17;
-        if (ng_cut_view < 0 || ng_cut_view >= static_cast<int>(seq_view.size())) continue;
-        int ng_cut_out = reverse ? (seq_len - 1 - ng_cut_view) : ng_cut_view;
-        if (ng_cut_out == cut_index_out) continue;  // avoid duplicating peg cut
-        int delta = std::abs(ng_cut_out - cut_index_out);
-        if (delta < best_dist && delta <= cfg.max_nick_to_edit_distance) {
-          best_dist = delta;
-          std::string ng_spacer = seq_view.substr(ng_spacer_start, 20);
-          ngrna = NickingSgRNA{ng_spacer, ng_cut_out, /*is_pe3b=*/false};
+}  // namespace
+
+SpecState prepare_spec(const PrimeEditSpec &edit) {
+  SpecState st;
+  st.reverse = (edit.strand == Strand::Minus);
+  st.seq_len = static_cast<int>(edit.ref_sequence.size());
+
+  // Validate once; the lift-over map carries edit coordinates into the edited view.
+  const auto normalized = normalize_edits(edit);
+  st.edited = apply_edits(edit.ref_sequence, normalized);
+  st.edit_start_orig = normalized.empty() ? 0 : normalized.front().ref_start;
+
+  // Last edited-view base the RTT must reach. Blocks are sorted, so the final block
+  // holds the furthest endpoint; a pure deletion must span its junction.
+  const auto &view_blocks = st.edited.lift.blocks(edit.strand);
+  if (!view_blocks.empty()) {
+    const auto &b = view_blocks.back();
+    st.edit_max_edit_view = (b.edited_end > b.edited_start) ? (b.edited_end - 1) : b.edited_start;
+  }
+
+  st.seq_view = st.reverse ? reverse_complement(edit.ref_sequence) : edit.ref_sequence;
+  st.seq_view_rc = reverse_complement(st.seq_view);
+  st.edited_view = st.reverse ? reverse_complement(st.edited.sequence) : st.edited.sequence;
+  return st;
+}
+
+CandidateList assemble_candidates(SpecState &st, const DesignConfig &cfg, const Device &device,
+                                  DesignSessionStats *stats) {
+  DesignSessionStats scratch;
+  DesignSessionStats &counters = stats ? *stats : scratch;
+  CandidateList out;
+
+  std::vector<MotifScan *> scans;
+  scans.reserve(cfg.pam_motifs.size());
+  bool any_hit = false;
+  bool any_reverse_hit = false;
+  for (const auto &motif : cfg.pam_motifs) {
+    scans.push_back(&scan_motif(st, motif, device, counters));
+    any_hit |= scans.back()->has_hit;
+    any_reverse_hit |= scans.back()->has_reverse_hit;
+  }
+  // ngRNAs come from opposite-strand hits when any exist, else from every hit.
+  const bool ngrna_reverse_only = any_reverse_hit;
+  const int edited_len = static_cast<int>(st.edited_view.size());
+
+  // Map nodes are stable, so the scan pointers survive later motif insertions.
+  for (MotifScan *scan : scans) {
+    for (NickSite &nick : scan->nicks) {
+      // Ensure edit within allowable distance using original coordinates.
+      int distance = std::abs(nick.cut_out - st.edit_start_orig);
+      bool edit_far = distance > cfg.max_nick_to_edit_distance;
+
+      // Optional companion ngRNA (PE3/PE3b): pick closest opposite-strand PAM.
+      std::optional<NickingSgRNA> ngrna;
+      if (cfg.design_ngrna && any_hit) {
+        int best_dist = std::numeric_limits<int>::max();
+        const NgSite *best = nullptr;
+        for (const MotifScan *ng_scan : scans) {
+          for (const auto &ng : ng_scan->ng_sites) {
+            if (ngrna_reverse_only && !ng.is_reverse) continue;
+            if (ng.cut_out == nick.cut_out) continue;  // avoid duplicating peg cut
+            int delta = std::abs(ng.cut_out - nick.cut_out);
+            if (delta < best_dist && delta <= cfg.max_nick_to_edit_distance) {
+              best_dist = delta;
+              best = &ng;
+            }
+          }
         }
+        if (best) ngrna = NickingSgRNA{best->spacer, best->cut_out, /*is_pe3b=*/false};
       }
-    }
 
-    for (int pbs_len = cfg.pbs_min_len; pbs_len <= cfg.pbs_max_len; ++pbs_len) {
-      if (cut_index_view - pbs_len < 0) continue;
-      std::string pbs_source = seq_view.substr(cut_index_view - pbs_len, pbs_len);
-      std::string pbs = reverse_complement(pbs_source);
+      const int rtt_lo =
+          std::max({cfg.rtt_min_len, st.edit_max_edit_view - nick.cut_edit + 1, 0});
+      const int rtt_hi = std::min(cfg.rtt_max_len, edited_len - nick.cut_edit);
+      if (rtt_lo > rtt_hi) continue;
 
-      for (int rtt_len = cfg.rtt_min_len; rtt_len <= cfg.rtt_max_len; ++rtt_len) {
-        if (cut_index_view + rtt_len > static_cast<int>(edited_view.size())) continue;
-        // Require RTT to cover edit window in view coordinates.
-        if (edit_max_view >= cut_index_view + rtt_len) continue;
+      for (int pbs_len = std::max(cfg.pbs_min_len, 0); pbs_len <= cfg.pbs_max_len; ++pbs_len) {
+        if (nick.cut_view - pbs_len < 0) break;
+        const SeqPiece &pbs = pbs_piece(st, nick, pbs_len, counters);
 
-        std::string rtt = edited_view.substr(cut_index_view, rtt_len);
+        for (int rtt_len = rtt_lo; rtt_len <= rtt_hi; ++rtt_len) {
+          const SeqPiece &rtt = rtt_piece(st, nick, rtt_len, counters);
+          PegRNA peg{nick.spacer, nick.cut_out, pbs.seq, rtt.seq};
 
-        std::string spacer = seq_view.substr(spacer_start, 20);
-        PegRNA peg{spacer, cut_index_out, pbs, rtt};
+          CandidateHeuristics h{};
+          h.pbs_gc = pbs.gc;
+          h.rtt_gc = rtt.gc;
+          h.edit_distance_from_nick = distance;
+          h.flag_edit_far = edit_far;
+          h.flag_pbs_gc_extreme = (h.pbs_gc < 0.3 || h.pbs_gc > 0.75);
 
-        CandidateHeuristics h{};
-        h.pbs_gc = gc_content(pbs);
-        h.rtt_gc = gc_content(rtt);
-        h.edit_distance_from_nick = distance;
-        h.flag_edit_far = edit_far;
-        h.flag_pbs_gc_extreme = (h.pbs_gc < 0.3 || h.pbs_gc > 0.75);
-
-        PrimeCandidate cand{peg, ngrna, h};
-        out.push_back(std::move(cand));
+          PrimeCandidate cand{std::move(peg), ngrna, h};
+          out.push_back(std::move(cand));
+        }
       }
     }
   }
@@ -235,6 +202,12 @@ CandidateList design_prime_edit(const PrimeEditSpec &edit, const DesignConfig &c
   return out;
 }
 
+CandidateList design_prime_edit(const PrimeEditSpec &edit, const DesignConfig &cfg,
+                                const Device &device) {
+  SpecState st = prepare_spec(edit);
+  return assemble_candidates(st, cfg, device);
+}
+
 BatchCandidateList design_prime_edits(const std::vector<PrimeEditSpec> &edits,
                                       const DesignConfig &cfg, const Device &device) {
   BatchCandidateList batch;
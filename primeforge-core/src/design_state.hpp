@@ -0,0 +1,74 @@
+#pragma once
+
+// Per-spec intermediate design state shared by design_prime_edit and DesignSession.
+// Everything cached here depends only on the spec (and a motif, for scans); config
+// values are applied in assemble_candidates so a cached state serves any DesignConfig.
+
+#include <map>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "primeforge/device.hpp"
+#include "primeforge/edits.hpp"
+#include "primeforge/session.hpp"
+#include "primeforge/types.hpp"
+
+namespace primeforge {
+
+struct PamHit {
+  size_t pam_idx{0};  // start index in seq_view
+  bool is_reverse{false};
+};
+
+struct SeqPiece {
+  std::string seq;
+  double gc{0.0};
+};
+
+// A forward hit usable as the pegRNA nick, with PBS/RTT pieces memoized by length.
+struct NickSite {
+  int spacer_start{0};
+  int cut_view{0};
+  int cut_out{0};   // cut in ref_sequence coordinates
+  int cut_edit{0};  // cut in edited-view coordinates
+  std::string spacer;
+  std::vector<std::optional<SeqPiece>> pbs;  // index = length
+  std::vector<std::optional<SeqPiece>> rtt;
+};
+
+// Any valid hit (either strand) usable as a PE3 nicking guide.
+struct NgSite {
+  bool is_reverse{false};
+  int cut_out{0};
+  std::string spacer;
+};
+
+struct MotifScan {
+  std::vector<NickSite> nicks;  // forward hits, scan order
+  std::vector<NgSite> ng_sites; // all valid hits, forward then reverse
+  bool has_reverse_hit{false};  // any reverse hit, valid or not
+  bool has_hit{false};
+};
+
+struct SpecState {
+  bool reverse{false};
+  int seq_len{0};
+  int edit_start_orig{0};
+  int edit_max_edit_view{0};
+  EditedWindow edited;
+  std::string seq_view;
+  std::string seq_view_rc;
+  std::string edited_view;
+  std::map<std::string, MotifScan> scans;  // keyed by motif
+};
+
+// Validate edits and build the config-independent views. Throws like normalize_edits.
+SpecState prepare_spec(const PrimeEditSpec &edit);
+
+// Apply cfg to a (possibly warm) state, scanning new motifs and building only the
+// PBS/RTT lengths not cached yet. stats, if given, counts the work done.
+CandidateList assemble_candidates(SpecState &state, const DesignConfig &cfg,
+                                  const Device &device, DesignSessionStats *stats = nullptr);
+
+}  // namespace primeforge
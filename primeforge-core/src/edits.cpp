@@ -0,0 +1,165 @@
+#include "primeforge/edits.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <stdexcept>
+#include <utility>
+
+namespace primeforge {
+namespace {
+
+[[noreturn]] void invalid_edit(const PrimeEditSpec &spec, const std::string &why) {
+  throw std::invalid_argument("edit spec '" + spec.id + "': " + why);
+}
+
+NormalizedEdit normalize_one(const PrimeEditSpec &spec, const EditVariant &edit) {
+  const int n = static_cast<int>(spec.ref_sequence.size());
+  if (std::holds_alternative<EditSubstitution>(edit)) {
+    const auto &e = std::get<EditSubstitution>(edit);
+    if (e.pos < 0 || e.pos >= n) {
+      invalid_edit(spec, "substitution at " + std::to_string(e.pos) + " outside window");
+    }
+    const char want = static_cast<char>(std::toupper(static_cast<unsigned char>(e.ref)));
+    const char have =
+        static_cast<char>(std::toupper(static_cast<unsigned char>(spec.ref_sequence[e.pos])));
+    // ref is optional: '\0' or 'N' skip the check.
+    if (want != '\0' && want != 'N' && want != have) {
+      invalid_edit(spec, "substitution ref '" + std::string(1, e.ref) + "' does not match '" +
+                             std::string(1, spec.ref_sequence[e.pos]) + "' at " +
+                             std::to_string(e.pos));
+    }
+    return {e.pos, e.pos + 1, std::string(1, e.alt)};
+  }
+  if (std::holds_alternative<EditInsertion>(edit)) {
+    const auto &e = std::get<EditInsertion>(edit);
+    if (e.pos < 0 || e.pos > n) {
+      invalid_edit(spec, "insertion at " + std::to_string(e.pos) + " outside window");
+    }
+    return {e.pos, e.pos, e.inserted};
+  }
+  const auto &e = std::get<EditDeletion>(edit);
+  if (e.length < 0 || e.start < 0 || e.start > n - e.length) {
+    invalid_edit(spec, "deletion " + std::to_string(e.start) + "+" + std::to_string(e.length) +
+                           " outside window");
+  }
+  return {e.start, e.start + e.length, std::string{}};
+}
+
+// Shared lift for both directions; `forward` maps ref -> edited. `left` keeps an empty
+// source block (insertion) anchored at pos in front of pos instead of behind it.
+int lift(const std::vector<LiftBlock> &blocks, int pos, int src_len, int dst_len, bool forward,
+         bool left = false) {
+  if (pos < 0 || pos > src_len) throw std::out_of_range("lift-over position outside sequence");
+  if (pos == src_len && !left) return dst_len;
+
+  const auto src_start = [forward](const LiftBlock &b) {
+    return forward ? b.ref_start : b.edited_start;
+  };
+  const auto src_end = [forward](const LiftBlock &b) {
+    return forward ? b.ref_end : b.edited_end;
+  };
+  const auto dst_start = [forward](const LiftBlock &b) {
+    return forward ? b.edited_start : b.ref_start;
+  };
+  const auto dst_end = [forward](const LiftBlock &b) {
+    return forward ? b.edited_end : b.ref_end;
+  };
+
+  // First block not entirely at or before pos; block ends are non-decreasing, and an
+  // insertion at pos sorts after any block ending at pos.
+  auto it = std::partition_point(blocks.begin(), blocks.end(), [&](const LiftBlock &b) {
+    return src_end(b) < pos || (src_end(b) == pos && !(left && src_start(b) == pos));
+  });
+  if (it != blocks.end() && src_start(*it) <= pos) return dst_start(*it);
+  if (it == blocks.begin()) return pos;
+  const auto &prev = *std::prev(it);
+  return pos + (dst_end(prev) - src_end(prev));
+}
+
+}  // namespace
+
+LiftOver::LiftOver(int ref_length, int edited_length, std::vector<LiftBlock> blocks)
+    : ref_length_(ref_length), edited_length_(edited_length), plus_blocks_(std::move(blocks)) {
+  minus_blocks_.reserve(plus_blocks_.size());
+  for (auto it = plus_blocks_.rbegin(); it != plus_blocks_.rend(); ++it) {
+    minus_blocks_.push_back(LiftBlock{ref_length_ - it->ref_end, ref_length_ - it->ref_start,
+                                      edited_length_ - it->edited_end,
+                                      edited_length_ - it->edited_start});
+  }
+}
+
+int LiftOver::to_edited(int ref_pos, Strand strand) const {
+  return lift(blocks(strand), ref_pos, ref_length_, edited_length_, /*forward=*/true);
+}
+
+int LiftOver::to_edited_left(int ref_pos, Strand strand) const {
+  return lift(blocks(strand), ref_pos, ref_length_, edited_length_, /*forward=*/true,
+              /*left=*/true);
+}
+
+int LiftOver::to_reference(int edited_pos, Strand strand) const {
+  return lift(blocks(strand), edited_pos, edited_length_, ref_length_, /*forward=*/false);
+}
+
+std::vector<NormalizedEdit> normalize_edits(const PrimeEditSpec &spec) {
+  std::vector<NormalizedEdit> raw;
+  raw.reserve(spec.edits.size());
+  for (const auto &ev : spec.edits) raw.push_back(normalize_one(spec, ev));
+
+  // Stable so same-index insertions keep their input order; insertions sort before
+  // a replacement starting at the same index.
+  std::stable_sort(raw.begin(), raw.end(), [](const auto &a, const auto &b) {
+    if (a.ref_start != b.ref_start) return a.ref_start < b.ref_start;
+    return a.ref_end < b.ref_end;
+  });
+
+  std::vector<NormalizedEdit> out;
+  out.reserve(raw.size());
+  for (auto &e : raw) {
+    if (!out.empty()) {
+      auto &prev = out.back();
+      const bool both_insertions = prev.ref_start == prev.ref_end && e.ref_start == e.ref_end;
+      if (both_insertions && prev.ref_start == e.ref_start) {
+        prev.alt += e.alt;
+        continue;
+      }
+      if (e.ref_start < prev.ref_end) {
+        invalid_edit(spec, "edits overlap at " + std::to_string(e.ref_start));
+      }
+    }
+    out.push_back(std::move(e));
+  }
+  return out;
+}
+
+EditedWindow apply_edits(const std::string &ref_sequence,
+                         const std::vector<NormalizedEdit> &edits) {
+  size_t out_len = ref_sequence.size();
+  for (const auto &e : edits) out_len = out_len - (e.ref_end - e.ref_start) + e.alt.size();
+
+  EditedWindow out;
+  out.sequence.reserve(out_len);
+  std::vector<LiftBlock> blocks;
+  blocks.reserve(edits.size());
+
+  int cursor = 0;
+  for (const auto &e : edits) {
+    out.sequence.append(ref_sequence, cursor, e.ref_start - cursor);
+    const int edited_start = static_cast<int>(out.sequence.size());
+    out.sequence.append(e.alt);
+    blocks.push_back(LiftBlock{e.ref_start, e.ref_end, edited_start,
+                               static_cast<int>(out.sequence.size())});
+    cursor = e.ref_end;
+  }
+  out.sequence.append(ref_sequence, cursor, std::string::npos);
+
+  out.lift = LiftOver(static_cast<int>(ref_sequence.size()),
+                      static_cast<int>(out.sequence.size()), std::move(blocks));
+  return out;
+}
+
+EditedWindow apply_edits(const PrimeEditSpec &spec) {
+  return apply_edits(spec.ref_sequence, normalize_edits(spec));
+}
+
+}  // namespace primeforge
@@ -5,6 +5,8 @@
 #include <stdexcept>
 #include <algorithm>
 
+#include "../cpu/seq_kernels.hpp"
+
 namespace primeforge {
 
 namespace {
@@ -38,10 +40,11 @@ std::vector<size_t> find_pam_sites_cuda(const std::string &seq, const std::strin
   if (seq.size() < motif.size()) return hits;
 
   // Uppercase copies so kernel is case-insensitive without extra branching.
-  std::string seq_host = seq;
-  std::string motif_host = motif;
-  std::transform(seq_host.begin(), seq_host.end(), seq_host.begin(), [](unsigned char c) { return std::toupper(c); });
-  std::transform(motif_host.begin(), motif_host.end(), motif_host.begin(), [](unsigned char c) { return std::toupper(c); });
+  const SeqKernels &kernels = seq_kernels();
+  std::string seq_host(seq.size(), '\0');
+  std::string motif_host(motif.size(), '\0');
+  kernels.to_upper(seq.data(), seq.size(), seq_host.data());
+  kernels.to_upper(motif.data(), motif.size(), motif_host.data());
 
   const int n = static_cast<int>(seq_host.size());
   const int m = static_cast<int>(motif_host.size());
@@ -0,0 +1,36 @@
+#include "primeforge/session.hpp"
+
+#include <stdexcept>
+#include <utility>
+
+#include "design_state.hpp"
+
+namespace primeforge {
+
+DesignSession::DesignSession(std::vector<PrimeEditSpec> edits, const Device &device)
+    : edits_(std::move(edits)), device_(device) {
+  states_.reserve(edits_.size());
+  for (const auto &e : edits_) {
+    states_.push_back(std::make_unique<SpecState>(prepare_spec(e)));
+  }
+}
+
+DesignSession::DesignSession(DesignSession &&) noexcept = default;
+DesignSession &DesignSession::operator=(DesignSession &&) noexcept = default;
+DesignSession::~DesignSession() = default;
+
+BatchCandidateList DesignSession::design(const DesignConfig &cfg) {
+  BatchCandidateList batch;
+  batch.reserve(states_.size());
+  for (auto &st : states_) {
+    batch.push_back(assemble_candidates(*st, cfg, device_, &stats_));
+  }
+  return batch;
+}
+
+CandidateList DesignSession::design_one(size_t spec, const DesignConfig &cfg) {
+  if (spec >= states_.size()) throw std::out_of_range("spec index outside design session");
+  return assemble_candidates(*states_[spec], cfg, device_, &stats_);
+}
+
+}  // namespace primeforge
@@ -1,37 +1,19 @@
 #include "primeforge/utils.hpp"
 
-#include <algorithm>
-#include <cctype>
+#include "cpu/seq_kernels.hpp"
 
 namespace primeforge {
 
-static char complement(char base) {
-  switch (std::toupper(static_cast<unsigned char>(base))) {
-    case 'A': return 'T';
-    case 'C': return 'G';
-    case 'G': return 'C';
-    case 'T': return 'A';
-    default: return 'N';
-  }
-}
-
 std::string reverse_complement(const std::string &seq) {
-  std::string rc;
-  rc.reserve(seq.size());
-  for (auto it = seq.rbegin(); it != seq.rend(); ++it) {
-    rc.push_back(complement(*it));
-  }
+  std::string rc(seq.size(), '\0');
+  seq_kernels().reverse_complement(seq.data(), seq.size(), rc.data());
   return rc;
 }
 
 double gc_content(const std::string &seq) {
   if (seq.empty()) return 0.0;
-  int gc = 0;
-  for (char c : seq) {
-    char u = std::toupper(static_cast<unsigned char>(c));
-    if (u == 'G' || u == 'C') ++gc;
-  }
-  return static_cast<double>(gc) / static_cast<double>(seq.size());
+  const BaseCounts counts = seq_kernels().count_gc_n(seq.data(), seq.size());
+  return static_cast<double>(counts.gc) / static_cast<double>(seq.size());
 }
 
 }  // namespace primeforge
@@ -0,0 +1,69 @@
+#pragma once
+
+// Shared spec generator and candidate comparison for the batch, store and session tests.
+
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "primeforge/types.hpp"
+
+namespace primeforge::testing {
+
+// n random windows, alternating strands, cycling through a substitution, a deletion and an
+// insertion + substitution pair around the window centre.
+inline std::vector<PrimeEditSpec> make_specs(size_t n, int window = 60, uint32_t seed = 11) {
+  static const char bases[4] = {'A', 'C', 'G', 'T'};
+  std::mt19937 rng(seed);
+  std::uniform_int_distribution<int> base(0, 3);
+  const int mid = window / 2;
+  std::vector<PrimeEditSpec> specs;
+  specs.reserve(n);
+  for (size_t i = 0; i < n; ++i) {
+    std::string seq(static_cast<size_t>(window), 'A');
+    for (auto &c : seq) c = bases[base(rng)];
+    PrimeEditSpec spec{.id = "spec-" + std::to_string(i), .ref_sequence = seq};
+    spec.strand = (i % 2) ? Strand::Minus : Strand::Plus;
+    switch (i % 3) {
+      case 0: spec.edits = {EditSubstitution{mid, seq[mid], seq[mid] == 'A' ? 'C' : 'A'}}; break;
+      case 1: spec.edits = {EditDeletion{mid - 2, 3}}; break;
+      default:
+        spec.edits = {EditInsertion{mid + 2, "GATC"}, EditSubstitution{mid + 5, seq[mid + 5], 'T'}};
+        break;
+    }
+    specs.push_back(std::move(spec));
+  }
+  return specs;
+}
+
+inline bool same_candidate(const PrimeCandidate &x, const PrimeCandidate &y) {
+  return x.peg.spacer == y.peg.spacer && x.peg.cut_index == y.peg.cut_index &&
+         x.peg.pbs == y.peg.pbs && x.peg.rtt == y.peg.rtt &&
+         x.ngrna.has_value() == y.ngrna.has_value() &&
+         (!x.ngrna || (x.ngrna->spacer == y.ngrna->spacer &&
+                       x.ngrna->cut_index == y.ngrna->cut_index &&
+                       x.ngrna->is_pe3b == y.ngrna->is_pe3b)) &&
+         x.heuristics.pbs_gc == y.heuristics.pbs_gc && x.heuristics.rtt_gc == y.heuristics.rtt_gc &&
+         x.heuristics.edit_distance_from_nick == y.heuristics.edit_distance_from_nick &&
+         x.heuristics.flag_pbs_gc_extreme == y.heuristics.flag_pbs_gc_extreme &&
+         x.heuristics.flag_edit_far == y.heuristics.flag_edit_far;
+}
+
+inline bool same_candidates(const CandidateList &a, const CandidateList &b) {
+  if (a.size() != b.size()) return false;
+  for (size_t i = 0; i < a.size(); ++i) {
+    if (!same_candidate(a[i], b[i])) return false;
+  }
+  return true;
+}
+
+inline bool same_candidates(const BatchCandidateList &a, const BatchCandidateList &b) {
+  if (a.size() != b.size()) return false;
+  for (size_t i = 0; i < a.size(); ++i) {
+    if (!same_candidates(a[i], b[i])) return false;
+  }
+  return true;
+}
+
+}  // namespace primeforge::testing
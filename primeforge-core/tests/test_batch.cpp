@@ -0,0 +1,165 @@
+#include <unistd.h>
+
+#include <cassert>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "batch/io.hpp"
+#include "batch/serialize.hpp"
+#include "fixtures.hpp"
+#include "primeforge/batch.hpp"
+#include "primeforge/design.hpp"
+
+using namespace primeforge;
+using primeforge::testing::make_specs;
+using primeforge::testing::same_candidates;
+namespace fs = std::filesystem;
+
+namespace {
+
+std::string slurp(const fs::path &p) {
+  std::ifstream in(p, std::ios::binary);
+  return std::string(std::istreambuf_iterator<char>(in), {});
+}
+
+}  // namespace
+
+int main() {
+  const fs::path dir = fs::temp_directory_path() / ("primeforge_test_batch_" + std::to_string(::getpid()));
+  fs::remove_all(dir);
+  fs::create_directories(dir);
+
+  // Concurrent writers of one path (e.g. the same shard on two hosts with equal PIDs)
+  // get distinct temp files; each commit publishes a complete file.
+  {
+    AtomicFile first(dir / "race.bin");
+    AtomicFile second(dir / "race.bin");
+    first.write("first writer");
+    second.write("second");
+    size_t temps = 0;
+    for (const auto &entry : fs::directory_iterator(dir)) {
+      temps += entry.path().filename().string().rfind("race.bin.tmp.", 0) == 0;
+    }
+    assert(temps == 2);
+    first.commit();
+    assert(slurp(dir / "race.bin") == "first writer");
+    second.commit();
+    assert(slurp(dir / "race.bin") == "second");
+  }
+
+  const auto specs = make_specs(41);
+  DesignConfig cfg{};
+  cfg.design_ngrna = true;
+
+  // Serial reference.
+  const auto serial = design_prime_edits(specs, cfg);
+  write_batch_results(serial, (dir / "serial.pfr").string());
+  assert(same_candidates(read_batch_results((dir / "serial.pfr").string()), serial));
+
+  // Sharded run across forked workers, merged back byte-for-byte.
+  BatchPlan plan = plan_batch(specs, cfg, (dir / "run").string(), /*shard_size=*/6);
+  assert(plan.shards.size() == 7);
+  assert(plan.shards.back().begin == 36 && plan.shards.back().end == 41);
+
+  auto stats = run_batch_local(plan, /*workers=*/3);
+  assert(stats.shards_run == 7 && stats.shards_skipped == 0);
+  merge_batch(plan, (dir / "merged.pfr").string());
+  assert(slurp(dir / "merged.pfr") == slurp(dir / "serial.pfr"));
+
+  // Resume: a lost and a torn shard are rerun; the rest are skipped.
+  const BatchPlan loaded = load_batch_plan((dir / "run").string());
+  assert(loaded.spec_count == 41 && loaded.shards.size() == plan.shards.size());
+  assert(loaded.shards[3].key == plan.shards[3].key);
+  fs::remove(dir / "run" / "results" / (plan.shards[2].key + ".pfr"));
+  std::ofstream(dir / "run" / "results" / (plan.shards[5].key + ".pfr"), std::ios::trunc) << "PFR1";
+  assert(!is_shard_complete(loaded, 2) && !is_shard_complete(loaded, 5));
+  stats = run_batch_local(loaded, /*workers=*/2);
+  assert(stats.shards_run == 2 && stats.shards_skipped == 5);
+  merge_batch(loaded, (dir / "merged2.pfr").string());
+  assert(slurp(dir / "merged2.pfr") == slurp(dir / "serial.pfr"));
+
+  // The checksum covers the header: a flipped header byte alone makes the shard incomplete.
+  const fs::path stale = dir / "run" / "results" / (plan.shards[4].key + ".pfr");
+  const std::string good_bytes = slurp(stale);
+  std::string stale_bytes = good_bytes;
+  stale_bytes[8] = static_cast<char>(kDesignVersion - 1);  // after magic + format version
+  std::ofstream(stale, std::ios::binary | std::ios::trunc) << stale_bytes;
+  assert(!is_shard_complete(loaded, 4));
+
+  // Re-sealed with a valid checksum, a count larger than the records is rejected before
+  // read_batch_results allocates for it.
+  const auto reseal = [](std::string bytes) {
+    ByteWriter sum;
+    sum.u64(fnv1a64(std::string_view(bytes).substr(0, bytes.size() - 8)));
+    bytes.replace(bytes.size() - 8, 8, sum.bytes());
+    return bytes;
+  };
+  std::string huge = good_bytes;
+  for (int i = 12; i < 20; ++i) huge[i] = static_cast<char>(0x7F);  // spec count
+  std::ofstream(dir / "huge.pfr", std::ios::binary) << reseal(huge);
+  bool threw = false;
+  try {
+    read_batch_results((dir / "huge.pfr").string());
+  } catch (const std::runtime_error &) {
+    threw = true;
+  }
+  assert(threw);
+
+  // A result from another design version with a valid checksum is stale: it is rerun, and
+  // merge_batch refuses to mix it in.
+  stale_bytes = reseal(stale_bytes);
+  std::ofstream(stale, std::ios::binary | std::ios::trunc) << stale_bytes;
+  assert(!is_shard_complete(loaded, 4));
+  bool refused = false;
+  try {
+    merge_batch(loaded, (dir / "mixed.pfr").string());
+  } catch (const std::runtime_error &) {
+    refused = true;
+  }
+  assert(refused && !fs::exists(dir / "mixed.pfr"));
+  stats = run_batch_local(loaded);
+  assert(stats.shards_run == 1 && stats.shards_skipped == 6);
+  assert(slurp(stale) != stale_bytes);
+
+  // Forked workers cannot inherit a CUDA context.
+  bool rejected = false;
+  try {
+    run_batch_local(plan, /*workers=*/2, Device::cuda());
+  } catch (const std::invalid_argument &) {
+    rejected = true;
+  }
+  assert(rejected);
+
+  // Manifests whose shards are out of order or do not tile [0, spec_count) are rejected.
+  const auto manifest_rejected = [&](const std::string &text) {
+    const fs::path bad = dir / "bad_plan";
+    fs::create_directories(bad);
+    std::ofstream(bad / "manifest.tsv", std::ios::trunc) << text;
+    try {
+      load_batch_plan(bad.string());
+    } catch (const std::runtime_error &) {
+      return true;
+    }
+    return false;
+  };
+  const std::string manifest = slurp(dir / "run" / "manifest.tsv");
+  const std::string header_line = manifest.substr(0, manifest.find('\n') + 1);
+  const std::string k = "0123456789abcdef";
+  const std::string prefix = header_line + "specs\t10\nshards\t2\n";
+  assert(!manifest_rejected(prefix + "0\t" + k + "\t0\t6\n1\t" + k + "\t6\t10\n"));
+  assert(manifest_rejected(prefix + "1\t" + k + "\t0\t6\n0\t" + k + "\t6\t10\n"));
+  assert(manifest_rejected(prefix + "0\t" + k + "\t0\t5\n1\t" + k + "\t6\t10\n"));
+  assert(manifest_rejected(prefix + "0\t" + k + "\t0\t6\n1\t" + k + "\t6\t9\n"));
+  assert(manifest_rejected(header_line + "specs\t1\nshards\t99999999999\n"));
+
+  // Re-planning unchanged input maps to the same content keys and finished results.
+  plan = plan_batch(specs, cfg, (dir / "run").string(), 6);
+  assert(run_batch_local(plan).shards_skipped == 7);
+
+  fs::remove_all(dir);
+  return 0;
+}
@@ -0,0 +1,184 @@
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <cassert>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "fixtures.hpp"
+#include "primeforge/candidate_store.hpp"
+#include "primeforge/design.hpp"
+
+using namespace primeforge;
+namespace fs = std::filesystem;
+
+namespace {
+
+// Shared specs plus the window variants the store encodes differently.
+std::vector<PrimeEditSpec> make_specs(size_t n) {
+  auto specs = testing::make_specs(n, 70, 5);
+  for (size_t i = 0; i < specs.size(); ++i) {
+    auto &seq = specs[i].ref_sequence;
+    if (i % 7 == 3) seq[45] = 'N';  // forces raw RTT storage
+    if (i % 5 == 4) {
+      for (auto &c : seq) c = static_cast<char>(c | 0x20);  // soft-masked window
+    }
+  }
+  return specs;
+}
+
+long peak_rss_kb() {
+  rusage usage{};
+  ::getrusage(RUSAGE_SELF, &usage);
+  return usage.ru_maxrss;
+}
+
+// Spill many small specs in a fresh child and return 0 if peak RSS grew by less than
+// limit_kb. Only the buffer, the current spec and the 8-byte block index may grow with
+// the run; a library-wide spacer dictionary would add ~1 KB per spec here.
+int spill_within_memory(const fs::path &dir, size_t n_specs, long limit_kb) {
+  static const char bases[4] = {'A', 'C', 'G', 'T'};
+  std::mt19937 rng(17);
+  std::vector<PrimeEditSpec> specs;
+  specs.reserve(n_specs);
+  for (size_t i = 0; i < n_specs; ++i) {
+    std::string seq(120, 'A');
+    for (auto &c : seq) c = bases[rng() % 4];
+    specs.push_back(PrimeEditSpec{.id = "m", .ref_sequence = seq,
+                                  .edits = {EditSubstitution{60, 'N', 'A'}}});
+  }
+  DesignConfig cfg{};
+  cfg.design_ngrna = true;
+  cfg.pbs_min_len = cfg.pbs_max_len = 13;
+  cfg.rtt_max_len = 12;
+  SpillOptions opts;
+  opts.memory_budget_bytes = size_t{1} << 20;
+
+  // Warm the allocator so the measurement sees only growth from the run itself.
+  design_prime_edits_spilled({specs.begin(), specs.begin() + 200}, cfg,
+                             (dir / "warm.pfc").string(), opts);
+  const long before = peak_rss_kb();
+  design_prime_edits_spilled(specs, cfg, (dir / "large.pfc").string(), opts);
+  const long growth = peak_rss_kb() - before;
+  if (growth >= limit_kb) std::fprintf(stderr, "spill grew peak RSS by %ld KB\n", growth);
+  return growth < limit_kb ? 0 : 1;
+}
+
+}  // namespace
+
+int main() {
+  const fs::path dir =
+      fs::temp_directory_path() / ("primeforge_test_store_" + std::to_string(::getpid()));
+  fs::create_directories(dir);
+
+  const auto specs = make_specs(30);
+  DesignConfig cfg{};
+  cfg.design_ngrna = true;
+  const auto expected = design_prime_edits(specs, cfg);
+  bool raw_rtt = false;
+  for (const auto &c : expected[10]) raw_rtt |= c.peg.rtt.find('N') != std::string::npos;
+  assert(raw_rtt);
+
+  // A tiny budget spills after nearly every spec.
+  SpillOptions opts;
+  opts.memory_budget_bytes = 512;
+  const std::string path = (dir / "cands.pfc").string();
+  CandidateStore store = design_prime_edits_spilled(specs, cfg, path, opts);
+  assert(store.spec_count() == specs.size());
+  assert(store.spacer_count(0) > 0);
+
+  size_t total = 0;
+  for (size_t s = specs.size(); s-- > 0;) {  // reverse order: random access, not streaming
+    assert(store.candidate_count(s) == expected[s].size());
+    const auto got = store.candidates(s);
+    assert(testing::same_candidates(got, expected[s]));
+    total += got.size();
+  }
+  assert(total > 0);
+  assert(testing::same_candidate(store.candidate(7, 0), expected[7][0]));
+
+  // Reopen independently; budget does not change the bytes on disk.
+  CandidateStore reopened = CandidateStore::open(path);
+  assert(reopened.candidate_count(12) == expected[12].size());
+  const std::string path_big = (dir / "cands_big.pfc").string();
+  design_prime_edits_spilled(specs, cfg, path_big);
+  std::ifstream a(path, std::ios::binary), b(path_big, std::ios::binary);
+  assert(std::string(std::istreambuf_iterator<char>(a), {}) ==
+         std::string(std::istreambuf_iterator<char>(b), {}));
+
+  bool threw = false;
+  try {
+    store.candidate(0, expected[0].size());
+  } catch (const std::out_of_range &) {
+    threw = true;
+  }
+  assert(threw);
+
+  std::ofstream(dir / "junk.pfc") << "not a candidate file at all, just text padding it out";
+  threw = false;
+  try {
+    CandidateStore::open((dir / "junk.pfc").string());
+  } catch (const std::runtime_error &) {
+    threw = true;
+  }
+  assert(threw);
+
+  // Corrupt offsets that pass open() must throw on access instead of reading past the map.
+  std::ifstream src(path, std::ios::binary);
+  const std::string good(std::istreambuf_iterator<char>(src), {});
+  const auto load_u32 = [](const std::string &bytes, size_t at) {
+    uint32_t v = 0;
+    for (int i = 0; i < 4; ++i) {
+      v |= static_cast<uint32_t>(static_cast<uint8_t>(bytes[at + i])) << (8 * i);
+    }
+    return v;
+  };
+  const auto throws_on_first = [&](const std::string &bytes, const char *name) {
+    const fs::path bad = dir / name;
+    std::ofstream(bad, std::ios::binary) << bytes;
+    CandidateStore corrupt = CandidateStore::open(bad.string());
+    try {
+      corrupt.candidate(0, 0);
+    } catch (const std::runtime_error &) {
+      return true;
+    }
+    return false;
+  };
+  assert(!expected[0].empty());
+
+  // First block starts after the 8-byte header: u32 n, seq_bytes, spacer_count,
+  // spacer_bytes, then 45 bytes of columns per candidate (seq_offset after 36), the
+  // packed bases and the block's spacer offsets.
+  const size_t n0 = expected[0].size();
+  const size_t block0 = 8;
+  std::string bad_seq = good;
+  const size_t seq_offset_col = block0 + 16 + 36 * n0;
+  for (int i = 0; i < 4; ++i) bad_seq[seq_offset_col + i] = static_cast<char>(0xF0);
+  assert(throws_on_first(bad_seq, "bad_seq.pfc"));
+
+  // Spacer id 0 belongs to the first candidate; point its end past the dictionary.
+  std::string bad_dict = good;
+  const size_t seq_bytes0 = load_u32(good, block0 + 4);
+  const size_t dict_offsets0 = block0 + 16 + 45 * n0 + seq_bytes0;
+  for (int i = 0; i < 4; ++i) bad_dict[dict_offsets0 + 4 + i] = static_cast<char>(0xF0);
+  assert(throws_on_first(bad_dict, "bad_dict.pfc"));
+
+  // Memory stays bounded as the library grows (measured in a child so earlier peaks
+  // in this process do not hide growth).
+  const pid_t child = ::fork();
+  assert(child >= 0);
+  if (child == 0) ::_exit(spill_within_memory(dir, 20000, 10 * 1024));
+  int status = 0;
+  ::waitpid(child, &status, 0);
+  assert(WIFEXITED(status) && WEXITSTATUS(status) == 0);
+
+  fs::remove_all(dir);
+  return 0;
+}
@@ -0,0 +1,147 @@
+#include <cassert>
+#include <stdexcept>
+#include <string>
+
+#include "primeforge/design.hpp"
+#include "primeforge/edits.hpp"
+#include "primeforge/utils.hpp"
+
+using namespace primeforge;
+
+namespace {
+
+bool throws_invalid(const PrimeEditSpec &spec) {
+  try {
+    normalize_edits(spec);
+  } catch (const std::invalid_argument &) {
+    return true;
+  }
+  return false;
+}
+
+}  // namespace
+
+int main() {
+  // Multiplexed edits: sub, insertion, deletion, sub (given out of order).
+  PrimeEditSpec spec{
+      .id = "multi",
+      .ref_sequence = "AAAACCCCGGGGTTTT",
+      .edits = {EditSubstitution{14, 'T', 'A'}, EditDeletion{8, 2}, EditSubstitution{1, 'A', 'G'},
+                EditInsertion{4, "TT"}},
+      .strand = Strand::Plus,
+  };
+  auto edited = apply_edits(spec);
+  assert(edited.sequence == "AGAATTCCCCGGTTAT");
+
+  const auto &lift = edited.lift;
+  assert(lift.ref_length() == 16 && lift.edited_length() == 16);
+  assert(lift.blocks().size() == 4);
+  assert(lift.to_edited(0) == 0);
+  assert(lift.to_edited(3) == 3);
+  assert(lift.to_edited(4) == 6);   // base after the insertion
+  assert(lift.to_edited(7) == 9);
+  assert(lift.to_edited(9) == 10);  // deleted base maps to the junction
+  assert(lift.to_edited(10) == 10);
+  assert(lift.to_edited(16) == 16);
+  assert(lift.to_edited_left(4) == 4);  // boundary before the insertion
+  assert(lift.to_edited_left(3) == 3);
+  assert(lift.to_edited_left(9) == 10);
+  assert(lift.to_edited_left(16) == 16);
+  assert(lift.to_reference(4) == 4);  // inserted base maps to its anchor
+  assert(lift.to_reference(6) == 4);
+  assert(lift.to_reference(10) == 10);
+
+  // Minus strand agrees with flipping plus-strand coordinates outside replaced blocks.
+  for (int v = 0; v < 16; ++v) {
+    const int ref_pos = 15 - v;
+    bool in_block = false;
+    for (const auto &b : lift.blocks()) {
+      in_block |= (ref_pos >= b.ref_start && ref_pos < b.ref_end);
+    }
+    if (in_block) continue;
+    assert(lift.to_edited(v, Strand::Minus) == 15 - lift.to_edited(ref_pos));
+    assert(lift.to_reference(lift.to_edited(v, Strand::Minus), Strand::Minus) == v);
+  }
+  assert(lift.to_edited(7, Strand::Minus) == 6);
+
+  // Same-index insertions concatenate in input order.
+  PrimeEditSpec ins{.id = "ins", .ref_sequence = "ACGT",
+                    .edits = {EditInsertion{2, "A"}, EditInsertion{2, "C"}}};
+  assert(apply_edits(ins).sequence == "ACACGT");
+
+  // Invalid edits are rejected instead of silently dropped.
+  PrimeEditSpec overlap{.id = "overlap", .ref_sequence = "ACGTACGT",
+                        .edits = {EditDeletion{2, 3}, EditSubstitution{3, 'T', 'A'}}};
+  assert(throws_invalid(overlap));
+  PrimeEditSpec inside{.id = "inside", .ref_sequence = "ACGTACGT",
+                       .edits = {EditDeletion{2, 3}, EditInsertion{4, "G"}}};
+  assert(throws_invalid(inside));
+  PrimeEditSpec range{.id = "range", .ref_sequence = "ACGT",
+                      .edits = {EditSubstitution{4, 'A', 'C'}}};
+  assert(throws_invalid(range));
+  PrimeEditSpec mismatch{.id = "mismatch", .ref_sequence = "ACGT",
+                         .edits = {EditSubstitution{0, 'G', 'C'}}};
+  assert(throws_invalid(mismatch));
+
+  // Design: RTT must cover an insertion in edited coordinates.
+  PrimeEditSpec design_ins{
+      .id = "design-ins",
+      .ref_sequence = "ACGTACCGACGTACGTACGTGGGACGTACGTACGTAC",
+      .edits = {EditInsertion{25, "TTTTT"}},
+      .strand = Strand::Plus,
+  };
+  DesignConfig cfg{};
+  cfg.pbs_min_len = 10;
+  cfg.pbs_max_len = 12;
+  cfg.rtt_min_len = 5;
+  cfg.rtt_max_len = 18;
+  auto cands = design_prime_edit(design_ins, cfg, Device::cpu());
+  assert(!cands.empty());
+  for (const auto &c : cands) {
+    assert(c.peg.cut_index == 17);
+    assert(c.peg.rtt.size() >= 13);
+    assert(c.peg.rtt.substr(8, 5) == "TTTTT");
+  }
+
+  // Minus strand: RTT is read from the reverse complement of the edited window.
+  design_ins.strand = Strand::Minus;
+  const std::string edited_rc = reverse_complement(apply_edits(design_ins).sequence);
+  for (const auto &c : design_prime_edit(design_ins, cfg, Device::cpu())) {
+    assert(edited_rc.find(c.peg.rtt) != std::string::npos);
+  }
+
+  // Insertion exactly at the nick leads the RTT on both strands.
+  const std::string nick_ref = "ACGTACCGACGTACGTACGTGGGACGTACGTACGTAC";
+  PrimeEditSpec at_nick{.id = "at-nick", .ref_sequence = nick_ref,
+                        .edits = {EditInsertion{17, "TTTTT"}}, .strand = Strand::Plus};
+  DesignConfig nick_cfg{};
+  nick_cfg.pbs_min_len = 10;
+  nick_cfg.pbs_max_len = 10;
+  nick_cfg.rtt_min_len = 5;
+  nick_cfg.rtt_max_len = 12;
+  cands = design_prime_edit(at_nick, nick_cfg, Device::cpu());
+  bool saw_nick = false;
+  for (const auto &c : cands) {
+    if (c.peg.cut_index != 17) continue;
+    saw_nick = true;
+    assert(c.peg.rtt.substr(0, 5) == "TTTTT");
+  }
+  assert(saw_nick && cands.front().peg.rtt == "TTTTT");
+
+  // Minus-strand nick at view cut v sits between plus bases L-1-v and L-v.
+  at_nick.edits.clear();
+  at_nick.strand = Strand::Minus;
+  const auto unedited = design_prime_edit(at_nick, nick_cfg, Device::cpu());
+  assert(!unedited.empty());
+  const int minus_cut = unedited.front().peg.cut_index;
+  at_nick.edits = {EditInsertion{minus_cut + 1, "TTTTT"}};
+  saw_nick = false;
+  for (const auto &c : design_prime_edit(at_nick, nick_cfg, Device::cpu())) {
+    if (c.peg.cut_index != minus_cut) continue;
+    saw_nick = true;
+    assert(c.peg.rtt.substr(0, 5) == "AAAAA");
+  }
+  assert(saw_nick);
+
+  return 0;
+}
@@ -0,0 +1,95 @@
+#include <cassert>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "cpu/seq_kernels.hpp"
+#include "primeforge/utils.hpp"
+
+using namespace primeforge;
+
+namespace {
+
+std::string random_bytes(size_t n, std::mt19937 &rng, bool dna_only) {
+  static const std::string alphabet = "ACGTacgtNn";
+  std::uniform_int_distribution<int> byte(0, 255);
+  std::uniform_int_distribution<size_t> pick(0, alphabet.size() - 1);
+  std::string s(n, '\0');
+  for (auto &c : s) {
+    c = dna_only ? alphabet[pick(rng)] : static_cast<char>(byte(rng));
+  }
+  return s;
+}
+
+void check_against_scalar(const SeqKernels &k, const std::string &s) {
+  const SeqKernels &ref = seq_kernels_scalar();
+  const size_t n = s.size();
+
+  std::string rc_ref(n, '\0'), rc(n, '\0');
+  ref.reverse_complement(s.data(), n, rc_ref.data());
+  k.reverse_complement(s.data(), n, rc.data());
+  assert(rc == rc_ref);
+
+  const BaseCounts c_ref = ref.count_gc_n(s.data(), n);
+  const BaseCounts c = k.count_gc_n(s.data(), n);
+  assert(c.gc == c_ref.gc && c.n == c_ref.n);
+
+  std::string up_ref(n, '\0'), up = s;
+  ref.to_upper(s.data(), n, up_ref.data());
+  k.to_upper(up.data(), n, up.data());  // in place
+  assert(up == up_ref);
+
+  assert(k.find_non_acgt(s.data(), n) == ref.find_non_acgt(s.data(), n));
+
+  std::vector<uint8_t> p_ref((n + 3) / 4, 0xFF), p((n + 3) / 4, 0xFF);
+  ref.pack_2bit(s.data(), n, p_ref.data());
+  k.pack_2bit(s.data(), n, p.data());
+  assert(p == p_ref);
+}
+
+}  // namespace
+
+int main() {
+  // Scalar reference semantics.
+  assert(reverse_complement("acgTNx") == "NNACGT");
+  assert(gc_content("GGccAT") == 4.0 / 6.0);
+  assert(gc_content("") == 0.0);
+
+  const SeqKernels &scalar = seq_kernels_scalar();
+  const std::string dna = "ACGTacgtA";
+  std::vector<uint8_t> packed(3, 0xFF);
+  scalar.pack_2bit(dna.data(), dna.size(), packed.data());
+  assert(packed[0] == 0xE4 && packed[1] == 0xE4 && packed[2] == 0x00);
+  assert(scalar.find_non_acgt(dna.data(), dna.size()) == dna.size());
+  assert(scalar.find_non_acgt("ACGNT", 5) == 3);
+
+  // PRIMEFORGE_SIMD spellings; typos cap at scalar instead of lifting the cap.
+  assert(parse_simd_level(nullptr) == SimdLevel::AVX512);
+  assert(parse_simd_level("") == SimdLevel::AVX512);
+  assert(parse_simd_level("scalar") == SimdLevel::Scalar);
+  assert(parse_simd_level("sse42") == SimdLevel::SSE42);
+  assert(parse_simd_level("sse4.2") == SimdLevel::SSE42);
+  assert(parse_simd_level("avx2") == SimdLevel::AVX2);
+  assert(parse_simd_level("avx512") == SimdLevel::AVX512);
+  assert(parse_simd_level("avx-2") == SimdLevel::Scalar);
+  assert(parse_simd_level("none") == SimdLevel::Scalar);
+
+  // Every compiled-in level the CPU supports must agree with scalar, including tails.
+  std::mt19937 rng(7);
+  for (SimdLevel level : {SimdLevel::SSE42, SimdLevel::AVX2, SimdLevel::AVX512}) {
+    const SeqKernels *k = seq_kernels_for(level);
+    if (!k) continue;
+    std::cout << "checking " << k->name << "\n";
+    for (size_t n : {0, 1, 3, 15, 16, 17, 31, 32, 33, 63, 64, 65, 127, 200, 1000}) {
+      check_against_scalar(*k, random_bytes(n, rng, /*dna_only=*/true));
+      check_against_scalar(*k, random_bytes(n, rng, /*dna_only=*/false));
+      // Invalid base placed late to exercise the vector body of find_non_acgt.
+      std::string late(n, 'G');
+      if (n > 0) late[n - 1] = '-';
+      check_against_scalar(*k, late);
+    }
+  }
+  return 0;
+}
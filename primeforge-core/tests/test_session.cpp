@@ -0,0 +1,111 @@
+#include <cassert>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "fixtures.hpp"
+#include "primeforge/design.hpp"
+#include "primeforge/session.hpp"
+
+using namespace primeforge;
+
+namespace {
+
+std::vector<PrimeEditSpec> make_specs(size_t n) {
+  auto specs = testing::make_specs(n, 80, 23);
+  // Insertions exactly at a nick (cut 17 on plus, cut 10 on minus).
+  const std::string nick_ref = "ACGTACCGACGTACGTACGTGGGACGTACGTACGTAC";
+  specs.push_back(PrimeEditSpec{.id = "nick-plus", .ref_sequence = nick_ref,
+                                .edits = {EditInsertion{17, "TTTTT"}}, .strand = Strand::Plus});
+  specs.push_back(PrimeEditSpec{.id = "nick-minus", .ref_sequence = nick_ref,
+                                .edits = {EditInsertion{11, "TTTTT"}}, .strand = Strand::Minus});
+  return specs;
+}
+
+}  // namespace
+
+int main() {
+  const auto specs = make_specs(24);
+  DesignSession session(specs);
+  assert(session.spec_count() == specs.size());
+
+  DesignConfig cfg{};
+  cfg.rtt_max_len = 20;
+  assert(testing::same_candidates(session.design(cfg), design_prime_edits(specs, cfg)));
+  const DesignSessionStats cold = session.stats();
+  for (const auto &c : session.design_one(specs.size() - 2, cfg)) {
+    if (c.peg.cut_index == 17) assert(c.peg.rtt.substr(0, 5) == "TTTTT");
+  }
+  for (const auto &c : session.design_one(specs.size() - 1, cfg)) {
+    if (c.peg.cut_index == 10) assert(c.peg.rtt.substr(0, 5) == "AAAAA");
+  }
+  assert(cold.pam_scans == specs.size());
+  assert(cold.pbs_built > 0 && cold.rtt_built > 0);
+
+  // Same config again: everything is cached.
+  assert(testing::same_candidates(session.design(cfg), design_prime_edits(specs, cfg)));
+  assert(session.stats().pam_scans == cold.pam_scans);
+  assert(session.stats().pbs_built == cold.pbs_built);
+  assert(session.stats().rtt_built == cold.rtt_built);
+
+  // Wider RTT range: no rescans; nicks that now reach the edit build their first PBS.
+  cfg.rtt_max_len = 40;
+  assert(testing::same_candidates(session.design(cfg), design_prime_edits(specs, cfg)));
+  assert(session.stats().pam_scans == cold.pam_scans);
+  assert(session.stats().rtt_built > cold.rtt_built);
+
+  // Companion ngRNAs reuse the cached scans and pieces.
+  DesignSessionStats before = session.stats();
+  cfg.design_ngrna = true;
+  assert(testing::same_candidates(session.design(cfg), design_prime_edits(specs, cfg)));
+  assert(session.stats().pam_scans == before.pam_scans);
+  assert(session.stats().pbs_built == before.pbs_built);
+  assert(session.stats().rtt_built == before.rtt_built);
+
+  // A new motif is scanned once per spec; the existing one is not.
+  cfg.pam_motifs.push_back("NAG");
+  assert(testing::same_candidates(session.design(cfg), design_prime_edits(specs, cfg)));
+  assert(session.stats().pam_scans == before.pam_scans + specs.size());
+
+  // Narrowing ranges and tightening the distance are answered from cache.
+  before = session.stats();
+  cfg.pbs_min_len = 10;
+  cfg.pbs_max_len = 12;
+  cfg.rtt_min_len = 12;
+  cfg.max_nick_to_edit_distance = 20;
+  assert(testing::same_candidates(session.design(cfg), design_prime_edits(specs, cfg)));
+  assert(session.stats().pam_scans == before.pam_scans);
+  assert(session.stats().pbs_built == before.pbs_built);
+  assert(session.stats().rtt_built == before.rtt_built);
+
+  // Dropping a motif changes the ngRNA pool but still matches a fresh run.
+  cfg.pam_motifs = {"NAG"};
+  assert(testing::same_candidates(session.design(cfg), design_prime_edits(specs, cfg)));
+
+  auto one = session.design_one(3, cfg);
+  assert(testing::same_candidates(one, design_prime_edit(specs[3], cfg)));
+
+  bool threw = false;
+  try {
+    session.design_one(specs.size(), cfg);
+  } catch (const std::out_of_range &) {
+    threw = true;
+  }
+  assert(threw);
+
+  // Bad specs fail at construction, like design_prime_edit.
+  PrimeEditSpec bad{.id = "bad", .ref_sequence = "ACGT", .edits = {EditDeletion{2, 9}}};
+  threw = false;
+  try {
+    DesignSession broken({bad});
+  } catch (const std::invalid_argument &) {
+    threw = true;
+  }
+  assert(threw);
+
+  DesignSession moved = std::move(session);
+  assert(moved.spec_count() == specs.size());
+  assert(testing::same_candidates(moved.design(cfg), design_prime_edits(specs, cfg)));
+
+  return 0;
+}
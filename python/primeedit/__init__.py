@@ -15,6 +15,17 @@ from .types import (
 )
 from .api import design_prime_edit, design_prime_edits
 from .api import is_cuda_available
+from .api import DesignSession
+from .api import (
+    plan_batch,
+    load_batch_plan,
+    run_shard,
+    run_batch_local,
+    merge_batch,
+    read_batch_results,
+    design_prime_edits_spilled,
+    open_candidate_store,
+)
 
 __all__ = [
     "EditSubstitution",
@@ -27,4 +38,13 @@ __all__ = [
     "design_prime_edit",
     "design_prime_edits",
     "is_cuda_available",
+    "DesignSession",
+    "plan_batch",
+    "load_batch_plan",
+    "run_shard",
+    "run_batch_local",
+    "merge_batch",
+    "read_batch_results",
+    "design_prime_edits_spilled",
+    "open_candidate_store",
 ]
@@ -1,5 +1,6 @@
 from __future__ import annotations
 
+import threading
 from typing import List
 
 from .types import (
@@ -27,13 +28,36 @@ try:  # pragma: no cover - compiled extension detection
         PrimeEditSpec as _CPrimeEditSpec,
         DesignConfig as _CDesignConfig,
         Strand as _CStrand,
+        DesignSession as _CDesignSession,
     )
 except ImportError:  # pragma: no cover
     _c_design = None
     _c_design_batch = None
     _c_is_cuda_available = lambda: False
     _CDevice = _CDeviceType = _CEditDeletion = _CEditInsertion = _CEditSubstitution = None
-    _CPrimeEditSpec = _CDesignConfig = _CStrand = None
+    _CPrimeEditSpec = _CDesignConfig = _CStrand = _CDesignSession = None
+
+try:  # pragma: no cover - batch support is POSIX-only
+    from primeforge_bindings import (
+        plan_batch as _c_plan_batch,
+        load_batch_plan as _c_load_batch_plan,
+        run_shard as _c_run_shard,
+        run_batch_local as _c_run_batch_local,
+        merge_batch as _c_merge_batch,
+        read_batch_results as _c_read_batch_results,
+        design_prime_edits_spilled as _c_design_spilled,
+        CandidateStore as _CCandidateStore,
+        SpillOptions as _CSpillOptions,
+    )
+except ImportError:  # pragma: no cover
+    _c_plan_batch = _c_load_batch_plan = _c_run_shard = None
+    _c_run_batch_local = _c_merge_batch = _c_read_batch_results = None
+    _c_design_spilled = _CCandidateStore = _CSpillOptions = None
+
+
+def _require_batch():
+    if _c_plan_batch is None:
+        raise RuntimeError("primeforge batch support not built; rebuild with PRIMEFORGE_BUILD_PYTHON=ON on a POSIX system")
 
 
 def _to_c_device(dev: Device | None):
@@ -100,3 +124,92 @@ def design_prime_edits(edits: List[PrimeEditSpec], cfg: DesignConfig, device: De
 
 def is_cuda_available() -> bool:
     return _c_is_cuda_available()
+
+
+class DesignSession:
+    """Reusable design state for sweeping DesignConfig values over one batch.
+
+    Each design() call only scans new PAM motifs and builds new PBS/RTT lengths;
+    results match design_prime_edits(edits, cfg) exactly.
+    """
+
+    def __init__(self, edits: List[PrimeEditSpec], device: Device | None = None):
+        if _CDesignSession is None:
+            raise RuntimeError("primeforge bindings not built; rebuild with PRIMEFORGE_BUILD_PYTHON=ON")
+        self._session = _CDesignSession([_to_c_edit_spec(e) for e in edits], _to_c_device(device))
+
+    def design(self, cfg: DesignConfig) -> List[List[PrimeCandidate]]:
+        return self._session.design(_to_c_design_config(cfg))
+
+    def design_one(self, spec: int, cfg: DesignConfig) -> List[PrimeCandidate]:
+        return self._session.design_one(spec, _to_c_design_config(cfg))
+
+    @property
+    def stats(self):
+        return self._session.stats
+
+    def __len__(self) -> int:
+        return len(self._session)
+
+
+def plan_batch(edits: List[PrimeEditSpec], cfg: DesignConfig, dir: str, shard_size: int = 1024):
+    """Split edits into content-addressed shards under `dir` and write the manifest."""
+    _require_batch()
+    c_edits = [_to_c_edit_spec(e) for e in edits]
+    return _c_plan_batch(c_edits, _to_c_design_config(cfg), dir, shard_size)
+
+
+def load_batch_plan(dir: str):
+    _require_batch()
+    return _c_load_batch_plan(dir)
+
+
+def run_shard(plan, shard_index: int, device: Device | None = None) -> None:
+    _require_batch()
+    _c_run_shard(plan, shard_index, _to_c_device(device))
+
+
+def run_batch_local(plan, workers: int = 1, device: Device | None = None):
+    """Run incomplete shards across `workers` forked processes; completed shards are skipped.
+
+    workers > 1 forks the interpreter without Python's fork hooks, so it is refused while
+    other Python threads are running; use run_shard from separately spawned processes
+    (e.g. multiprocessing with the "spawn" start method) in threaded programs.
+    """
+    _require_batch()
+    if workers > 1 and threading.active_count() > 1:
+        raise RuntimeError("run_batch_local(workers > 1) forks; call it from a single-threaded process")
+    return _c_run_batch_local(plan, workers, _to_c_device(device))
+
+
+def merge_batch(plan, out_path: str) -> None:
+    _require_batch()
+    _c_merge_batch(plan, out_path)
+
+
+def read_batch_results(path: str) -> List[List[PrimeCandidate]]:
+    _require_batch()
+    return _c_read_batch_results(path)
+
+
+def design_prime_edits_spilled(
+    edits: List[PrimeEditSpec],
+    cfg: DesignConfig,
+    path: str,
+    memory_budget_bytes: int = 256 << 20,
+    device: Device | None = None,
+):
+    """Design a batch into an on-disk candidate file and return an mmap-backed CandidateStore.
+
+    `store[i]` (or `store.candidates(i)`) decodes spec i's candidates on demand.
+    """
+    _require_batch()
+    opts = _CSpillOptions()
+    opts.memory_budget_bytes = memory_budget_bytes
+    c_edits = [_to_c_edit_spec(e) for e in edits]
+    return _c_design_spilled(c_edits, _to_c_design_config(cfg), path, opts, _to_c_device(device))
+
+
+def open_candidate_store(path: str):
+    _require_batch()
+    return _CCandidateStore.open(path)
@@ -4,6 +4,11 @@
 #include "primeforge/design.hpp"
 #include "primeforge/pam.hpp"
 #include "primeforge/device.hpp"
+#include "primeforge/session.hpp"
+#ifdef PRIMEFORGE_WITH_BATCH
+#include "primeforge/batch.hpp"
+#include "primeforge/candidate_store.hpp"
+#endif
 
 namespace py = pybind11;
 using namespace primeforge;
@@ -86,4 +91,69 @@ PYBIND11_MODULE(primeforge_bindings, m) {
   m.def("design_prime_edits", &design_prime_edits, py::arg("edits"), py::arg("cfg"),
         py::arg("device") = Device::cpu());
   m.def("is_cuda_available", &is_cuda_available);
+
+  py::class_<DesignSessionStats>(m, "DesignSessionStats")
+      .def_readonly("pam_scans", &DesignSessionStats::pam_scans)
+      .def_readonly("pbs_built", &DesignSessionStats::pbs_built)
+      .def_readonly("rtt_built", &DesignSessionStats::rtt_built);
+
+  py::class_<DesignSession>(m, "DesignSession")
+      .def(py::init<std::vector<PrimeEditSpec>, const Device &>(), py::arg("edits"),
+           py::arg("device") = Device::cpu())
+      .def("design", &DesignSession::design, py::arg("cfg"))
+      .def("design_one", &DesignSession::design_one, py::arg("spec"), py::arg("cfg"))
+      .def_property_readonly("stats", &DesignSession::stats)
+      .def("__len__", &DesignSession::spec_count);
+
+#ifdef PRIMEFORGE_WITH_BATCH
+  py::class_<ShardInfo>(m, "ShardInfo")
+      .def_readonly("index", &ShardInfo::index)
+      .def_readonly("key", &ShardInfo::key)
+      .def_readonly("begin", &ShardInfo::begin)
+      .def_readonly("end", &ShardInfo::end);
+
+  py::class_<BatchPlan>(m, "BatchPlan")
+      .def_readonly("dir", &BatchPlan::dir)
+      .def_readonly("spec_count", &BatchPlan::spec_count)
+      .def_readonly("shards", &BatchPlan::shards);
+
+  py::class_<BatchRunStats>(m, "BatchRunStats")
+      .def_readonly("shards_total", &BatchRunStats::shards_total)
+      .def_readonly("shards_skipped", &BatchRunStats::shards_skipped)
+      .def_readonly("shards_run", &BatchRunStats::shards_run);
+
+  m.def("plan_batch", &plan_batch, py::arg("edits"), py::arg("cfg"), py::arg("dir"),
+        py::arg("shard_size") = 1024);
+  m.def("load_batch_plan", &load_batch_plan, py::arg("dir"));
+  m.def("is_shard_complete", &is_shard_complete, py::arg("plan"), py::arg("shard_index"));
+  m.def("run_shard", &run_shard, py::arg("plan"), py::arg("shard_index"),
+        py::arg("device") = Device::cpu());
+  m.def("run_batch_local", &run_batch_local, py::arg("plan"), py::arg("workers") = 1,
+        py::arg("device") = Device::cpu());
+  m.def("merge_batch", &merge_batch, py::arg("plan"), py::arg("out_path"));
+  m.def("write_batch_results", &write_batch_results, py::arg("batch"), py::arg("path"));
+  m.def("read_batch_results", &read_batch_results, py::arg("path"));
+
+  py::class_<SpillOptions>(m, "SpillOptions")
+      .def(py::init<>())
+      .def_readwrite("memory_budget_bytes", &SpillOptions::memory_budget_bytes);
+
+  py::class_<CandidateStore>(m, "CandidateStore")
+      .def_static("open", &CandidateStore::open, py::arg("path"))
+      .def_property_readonly("path", &CandidateStore::path)
+      .def_property_readonly("spec_count", &CandidateStore::spec_count)
+      .def("candidate_count", &CandidateStore::candidate_count, py::arg("spec"))
+      .def("candidate", &CandidateStore::candidate, py::arg("spec"), py::arg("index"))
+      .def("candidates", &CandidateStore::candidates, py::arg("spec"))
+      .def("__len__", &CandidateStore::spec_count)
+      .def("__getitem__", [](const CandidateStore &s, py::ssize_t spec) {
+        if (spec < 0) spec += static_cast<py::ssize_t>(s.spec_count());
+        if (spec < 0 || static_cast<size_t>(spec) >= s.spec_count()) throw py::index_error();
+        return s.candidates(static_cast<size_t>(spec));
+      });
+
+  m.def("design_prime_edits_spilled", &design_prime_edits_spilled, py::arg("edits"),
+        py::arg("cfg"), py::arg("path"), py::arg("opts") = SpillOptions{},
+        py::arg("device") = Device::cpu());
+#endif
 }
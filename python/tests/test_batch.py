@@ -0,0 +1,73 @@
+import pytest
+
+pytest.importorskip("primeforge_bindings")
+
+from primeedit import (
+    DesignConfig,
+    EditSubstitution,
+    PrimeEditSpec,
+    design_prime_edits,
+    design_prime_edits_spilled,
+    merge_batch,
+    open_candidate_store,
+    plan_batch,
+    read_batch_results,
+    run_batch_local,
+)
+
+
+def test_sharded_run_matches_serial(tmp_path):
+    seq = "ACGTACCGACGTACGTACGTGGGACGTACGTACGTAC"
+    edits = [
+        PrimeEditSpec(id=f"py-{i}", ref_sequence=seq, edits=[EditSubstitution(25, "G", "A")])
+        for i in range(5)
+    ]
+    cfg = DesignConfig()
+
+    plan = plan_batch(edits, cfg, str(tmp_path / "run"), shard_size=2)
+    assert len(plan.shards) == 3
+    stats = run_batch_local(plan, workers=2)
+    assert stats.shards_run == 3
+    assert run_batch_local(plan).shards_skipped == 3
+
+    merge_batch(plan, str(tmp_path / "merged.pfr"))
+    merged = read_batch_results(str(tmp_path / "merged.pfr"))
+    serial = design_prime_edits(edits, cfg)
+    assert [[c.peg.rtt for c in cands] for cands in merged] == [
+        [c.peg.rtt for c in cands] for cands in serial
+    ]
+
+
+def test_spilled_store_random_access(tmp_path):
+    seq = "ACGTACCGACGTACGTACGTGGGACGTACGTACGTAC"
+    edits = [
+        PrimeEditSpec(id=f"spill-{i}", ref_sequence=seq, edits=[EditSubstitution(25, "G", "A")])
+        for i in range(4)
+    ]
+    cfg = DesignConfig()
+    path = str(tmp_path / "cands.pfc")
+    store = design_prime_edits_spilled(edits, cfg, path, memory_budget_bytes=1024)
+    serial = design_prime_edits(edits, cfg)
+    assert len(store) == 4
+    assert [c.peg.rtt for c in store[-1]] == [c.peg.rtt for c in serial[3]]
+    reopened = open_candidate_store(path)
+    assert reopened.candidate_count(2) == len(serial[2])
+
+
+def test_forked_run_refused_with_live_threads(tmp_path):
+    import threading
+
+    seq = "ACGTACCGACGTACGTACGTGGGACGTACGTACGTAC"
+    edits = [PrimeEditSpec(id=f"t-{i}", ref_sequence=seq, edits=[EditSubstitution(25, "G", "A")]) for i in range(4)]
+    plan = plan_batch(edits, DesignConfig(), str(tmp_path / "run"), shard_size=2)
+
+    stop = threading.Event()
+    worker = threading.Thread(target=stop.wait)
+    worker.start()
+    try:
+        with pytest.raises(RuntimeError):
+            run_batch_local(plan, workers=2)
+    finally:
+        stop.set()
+        worker.join()
+    assert run_batch_local(plan, workers=2).shards_run == 2
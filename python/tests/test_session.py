@@ -0,0 +1,25 @@
+import pytest
+
+pytest.importorskip("primeforge_bindings")
+
+from primeedit import DesignConfig, DesignSession, EditSubstitution, PrimeEditSpec, design_prime_edits
+
+
+def _key(c):
+    return (c.peg.spacer, c.peg.cut_index, c.peg.pbs, c.peg.rtt, c.ngrna is not None)
+
+
+def test_session_matches_fresh_design_across_configs():
+    seq = "ACGTACCGACGTACGTACGTGGGACGTACGTACGTAC"
+    edits = [PrimeEditSpec(id="s", ref_sequence=seq, edits=[EditSubstitution(25, "G", "A")])]
+    session = DesignSession(edits)
+    assert len(session) == 1
+
+    cfg = DesignConfig(rtt_max_len=20)
+    for tweak in ({}, {"rtt_max_len": 30}, {"design_ngrna": True}, {"pam_motifs": ["NGG", "NAG"]}):
+        for k, v in tweak.items():
+            setattr(cfg, k, v)
+        got = [[_key(c) for c in cands] for cands in session.design(cfg)]
+        want = [[_key(c) for c in cands] for cands in design_prime_edits(edits, cfg)]
+        assert got == want
+    assert session.stats.pam_scans == 2